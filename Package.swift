@@ -19,7 +19,11 @@ let package = Package(
             ],
             path: "src",
             sources: [
-                "sqlite_orm/aasset_vfs.cpp"
+                "sqlite_orm/aasset_vfs.cpp",
+                "sqlite_orm/compressed_vfs.cpp",
+                "sqlite_orm/lz4.cpp",
+                "sqlite_orm/mapped_file.cpp",
+                "sqlite_orm/mmap_vfs.cpp"
             ],
             publicHeadersPath: "include"
         )
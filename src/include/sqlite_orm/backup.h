@@ -0,0 +1,142 @@
+//
+//  backup.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "sqlite3.h"
+
+namespace sqlite {
+
+    // Online backup running on its own thread and its own source connection, so the cached
+    // connection is never locked by it. Writes to the source made through other connections
+    // restart the copy from the first page. In WAL mode the steps don't block writers.
+
+    class backup {
+    public:
+
+        using progress = std::function<void(int remaining, int page_count)>;
+
+    public:
+
+        backup(sqlite3 *const db, const std::string &path, int pages_per_step, std::chrono::milliseconds pause,
+               const progress &progress) :
+                m_db(db), m_path(path), m_pages_per_step(pages_per_step), m_pause(pause), m_progress(progress) {
+            m_thread = std::thread(&backup::run, this);
+        }
+
+        ~backup() {
+            cancel();
+            wait();
+        }
+
+        backup(const backup &) = delete;
+
+        backup &operator=(const backup &) = delete;
+
+    public:
+
+        void cancel() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_cancelled = true;
+            m_condition.notify_all();
+        }
+
+        int wait() {
+            if (m_thread.joinable()) {
+                m_thread.join();
+            }
+
+            return m_result;
+        }
+
+        bool is_done() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_done;
+        }
+
+    private:
+
+        sqlite3 *const m_db;
+        const std::string m_path;
+        const int m_pages_per_step;
+        const std::chrono::milliseconds m_pause;
+        const progress m_progress;
+
+        std::thread m_thread;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_cancelled = false;
+        bool m_done = false;
+
+        int m_result = SQLITE_OK;
+
+    private:
+
+        void run() {
+            sqlite3 *source = m_db;
+            sqlite3 *own_source = nullptr;
+
+            const auto filename = sqlite3_db_filename(m_db, "main");
+            if (filename && *filename) {
+                sqlite3_vfs *vfs = nullptr;
+                sqlite3_file_control(m_db, "main", SQLITE_FCNTL_VFS_POINTER, &vfs);
+
+                const auto vfs_name = vfs ? vfs->zName : nullptr;
+                if (sqlite3_open_v2(filename, &own_source, SQLITE_OPEN_READONLY, vfs_name) == SQLITE_OK) {
+                    source = own_source;
+                }
+            }
+
+            sqlite3 *destination = nullptr;
+            auto rc = sqlite3_open_v2(m_path.c_str(), &destination, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE,
+                                      nullptr);
+
+            if (rc == SQLITE_OK) {
+                const auto backup = sqlite3_backup_init(destination, "main", source, "main");
+                if (backup) {
+                    do {
+                        rc = sqlite3_backup_step(backup, m_pages_per_step);
+
+                        if (m_progress) {
+                            m_progress(sqlite3_backup_remaining(backup), sqlite3_backup_pagecount(backup));
+                        }
+                    } while ((rc == SQLITE_OK || rc == SQLITE_BUSY || rc == SQLITE_LOCKED) && sleep());
+
+                    sqlite3_backup_finish(backup);
+                }
+
+                rc = sqlite3_errcode(destination);
+            }
+
+            sqlite3_close(destination);
+            sqlite3_close(own_source);
+
+            //
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_result = m_cancelled ? SQLITE_INTERRUPT : rc;
+            m_done = true;
+        }
+
+        bool sleep() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait_for(lock, m_pause, [this] { return m_cancelled; });
+            return !m_cancelled;
+        }
+
+    };
+
+}
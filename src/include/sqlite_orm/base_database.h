@@ -8,14 +8,25 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
 #include <functional>
 #include <list>
 #include <memory>
 #include <string>
 #include <sstream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "backup.h"
 #include "column.h"
+#include "data_version_watcher.h"
+#include "hooks.h"
+#include "statement_cache.h"
 #include "sqlite3.h"
 
 namespace sqlite {
@@ -41,6 +52,16 @@ namespace sqlite {
             }
             m_all_fields.pop_back();
 
+            m_selected_fields.clear();
+            for (const auto &f: m_fields) {
+                m_selected_fields += get_read_expression(f);
+                if (f.get_type() == column<T>::type::JSON && has_jsonb()) {
+                    m_selected_fields += " AS " + f.get_name();
+                }
+                m_selected_fields += ",";
+            }
+            m_selected_fields.pop_back();
+
             //
 
             const auto &id = m_fields.front();
@@ -49,12 +70,20 @@ namespace sqlite {
             m_all_fields_with_types += " integer primary key";
 
             for (size_t i = 1; i < m_fields.size(); ++i) {
-                const auto &f = m_fields[i];
                 m_all_fields_with_types += ", ";
-                m_all_fields_with_types += f.get_name();
+                m_all_fields_with_types += get_declaration(m_fields[i]);
+            }
 
-                m_all_fields_with_types += ' ';
-                m_all_fields_with_types += to_string(f.get_type());
+            m_json_paths.clear();
+
+            //
+
+            m_fingerprint = fnv_offset_basis;
+            for (const auto &f: m_fields) {
+                for (const auto c: f.get_name()) {
+                    m_fingerprint = (m_fingerprint ^ uint8_t(c)) * fnv_prime;
+                }
+                m_fingerprint = (m_fingerprint ^ uint8_t(f.get_type())) * fnv_prime;
             }
         }
 
@@ -64,7 +93,108 @@ namespace sqlite {
                     return "integer";
                 case sqlite::column<T>::type::STRING:
                     return "text";
+                case sqlite::column<T>::type::JSON:
+                    return has_jsonb() ? "blob" : "text";
+            }
+        }
+
+        // JSON documents are stored as JSONB when the library has it (3.45), so that paths are read
+        // without parsing the text. Rows holding text still pass the check and read back the same.
+
+        static bool has_jsonb() {
+            static const bool supported = sqlite3_libversion_number() >= 3045000;
+            return supported;
+        }
+
+        std::string get_declaration(const column<T> &f) {
+            auto declaration = f.get_name() + ' ' + to_string(f.get_type());
+            if (f.get_type() == column<T>::type::JSON) {
+                declaration += " CHECK(" + f.get_name() + " IS NULL OR json_valid(" + f.get_name() +
+                               (has_jsonb() ? ",5))" : "))");
+            }
+            return declaration;
+        }
+
+        // Field as read into objects, and the placeholder it's written with
+
+        static std::string get_read_expression(const column<T> &f, const std::string &qualifier = {}) {
+            if (f.get_type() == column<T>::type::JSON && has_jsonb()) {
+                return "json(" + qualifier + f.get_name() + ")";
+            }
+            return qualifier + f.get_name();
+        }
+
+        static const char *get_parameter(const column<T> &f) {
+            return f.get_type() == column<T>::type::JSON && has_jsonb() ? "jsonb(?)" : "?";
+        }
+
+        // Generated column holding the value at a JSON path of a field, so that it can be indexed.
+        // Declared after the fields, stored ones only take effect in tables created afterwards.
+
+        void set_json_path(const std::string &name, std::string T::* const field, const std::string &path,
+                           bool stored = false) {
+            const auto declaration = name + " GENERATED ALWAYS AS (" + get_json_extract(field, path) + ") " +
+                                     (stored ? "STORED" : "VIRTUAL");
+            m_json_paths.push_back({name, field, path, stored, declaration, false});
+
+            m_all_fields_with_types += ", ";
+            m_all_fields_with_types += declaration;
+
+            for (const auto c: declaration) {
+                m_fingerprint = (m_fingerprint ^ uint8_t(c)) * fnv_prime;
+            }
+        }
+
+        std::string get_json_extract(std::string T::* const field, const std::string &path) const {
+            std::string literal;
+            for (const auto c: path) {
+                literal += c;
+                if (c == '\'') {
+                    literal += c;
+                }
+            }
+            return "json_extract(" + find(field)->get_name() + ",'" + literal + "')";
+        }
+
+        // Columns of a unique key, the conflict target of upserts instead of the id
+
+        template<class... K>
+        void set_unique_key(K T::* const ... keys) {
+            m_unique_key.clear();
+            (m_unique_key.push_back(find_column(keys)), ...);
+        }
+
+        std::string get_unique_key() const {
+            if (m_unique_key.empty()) {
+                return m_fields.front().get_name();
+            }
+
+            std::string key;
+            for (const auto i: m_unique_key) {
+                key += m_fields[i].get_name();
+                key += ',';
+            }
+            key.pop_back();
+            return key;
+        }
+
+        // Updates the other columns of the row in place when the unique key already exists
+
+        std::string get_upsert_clause() const {
+            std::string set;
+            for (size_t i = 1; i < m_fields.size(); ++i) {
+                if (std::find(m_unique_key.begin(), m_unique_key.end(), i) == m_unique_key.end()) {
+                    const auto &name = m_fields[i].get_name();
+                    set += name + "=excluded." + name + ',';
+                }
+            }
+
+            if (set.empty()) {
+                return "ON CONFLICT(" + get_unique_key() + ") DO NOTHING";
             }
+
+            set.pop_back();
+            return "ON CONFLICT(" + get_unique_key() + ") DO UPDATE SET " + set;
         }
 
         std::string get_query() const {
@@ -75,6 +205,57 @@ namespace sqlite {
             return m_errors;
         }
 
+        bool serialize(const std::string &path) const {
+            sqlite3_int64 size = 0;
+            auto data = sqlite3_serialize(m_db, "main", &size, SQLITE_SERIALIZE_NOCOPY);
+
+            const bool copied = !data;
+            if (copied) {
+                data = sqlite3_serialize(m_db, "main", &size, 0);
+                if (!data) {
+                    return false;
+                }
+            }
+
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char *>(data), std::streamsize(size));
+
+            if (copied) {
+                sqlite3_free(data);
+            }
+
+            return bool(file);
+        }
+
+        std::shared_ptr<sqlite::backup> backup_to(const std::string &path, int pages_per_step = 100,
+                                                  std::chrono::milliseconds pause = std::chrono::milliseconds(10),
+                                                  const sqlite::backup::progress &progress = {}) const {
+            return std::make_shared<sqlite::backup>(m_db, path, pages_per_step, pause, progress);
+        }
+
+        // Token that changes with every commit to the file, made by any connection or process
+
+        uint32_t get_data_version() const {
+
+            // Starting a read transaction makes the pager notice commits of other connections
+
+            sqlite3_exec(m_db, "PRAGMA data_version", nullptr, nullptr, nullptr);
+
+            unsigned int version = 0;
+            sqlite3_file_control(m_db, "main", SQLITE_FCNTL_DATA_VERSION, &version);
+            return version;
+        }
+
+        bool changed_since(uint32_t data_version) const {
+            return get_data_version() != data_version;
+        }
+
+        std::shared_ptr<sqlite::data_version_watcher>
+        watch_data_version(const sqlite::data_version_watcher::callback &callback,
+                           std::chrono::milliseconds interval = std::chrono::milliseconds(100)) const {
+            return std::make_shared<sqlite::data_version_watcher>(m_db, interval, callback);
+        }
+
     protected:
 
         sqlite3 *m_db;
@@ -83,7 +264,22 @@ namespace sqlite {
 
         std::vector<sqlite::column<T>> m_fields;
         std::string m_all_fields;
+        std::string m_selected_fields;
         std::string m_all_fields_with_types;
+        uint32_t m_fingerprint = 0;
+        std::vector<std::string> m_parameters;
+        std::vector<size_t> m_unique_key;
+
+        struct json_path_column {
+            std::string name;
+            std::string T::*field;
+            std::string path;
+            bool stored;
+            std::string declaration;
+            bool missing;
+        };
+
+        std::vector<json_path_column> m_json_paths;
 
         int T::*m_int_pointer;
         std::string T::*m_string_pointer;
@@ -92,11 +288,36 @@ namespace sqlite {
 
         static const size_t errors_max_count = 10;
 
+        static const uint32_t fnv_offset_basis = 2166136261u;
+        static const uint32_t fnv_prime = 16777619u;
+
         std::list<std::string> m_errors;
 
     protected:
 
         bool iterate(const std::function<void(sqlite3_stmt *)> &fn) {
+            if (!m_parameters.empty()) {
+                const auto statement = prepare_bound();
+                if (!statement) {
+                    clear();
+                    return false;
+                }
+
+                try {
+                    while (sqlite3_step(statement) == SQLITE_ROW) {
+                        fn(statement);
+                    }
+                } catch (...) {
+                    finish_bound(statement);
+                    clear();
+                    throw;
+                }
+                finish_bound(statement);
+
+                clear();
+                return true;
+            }
+
             sqlite3_stmt *statement;
             const auto status = sqlite3_prepare(m_db, m_query.str().c_str(), -1, &statement, nullptr);
             if (status != SQLITE_OK) {
@@ -104,8 +325,16 @@ namespace sqlite {
                 return false;
             }
 
-            while (sqlite3_step(statement) == SQLITE_ROW) {
-                fn(statement);
+            // The query is cleared even when reading a row throws, so it doesn't prefix the next one
+
+            try {
+                while (sqlite3_step(statement) == SQLITE_ROW) {
+                    fn(statement);
+                }
+            } catch (...) {
+                sqlite3_finalize(statement);
+                clear();
+                throw;
             }
             sqlite3_finalize(statement);
 
@@ -159,7 +388,47 @@ namespace sqlite {
             }
         }
 
-        constexpr inline int convert(long long l) const {
+        // Native reads of a column by the requested type
+
+        template<class V>
+        static V read_column(sqlite3_stmt *statement, int i) {
+            if constexpr (std::is_floating_point_v<V>) {
+                return V(sqlite3_column_double(statement, i));
+            } else if constexpr (std::is_integral_v<V>) {
+                return V(sqlite3_column_int64(statement, i));
+            } else {
+                const auto text = sqlite3_column_text(statement, i);
+                return text ? V(reinterpret_cast<const char *>(text), size_t(sqlite3_column_bytes(statement, i))) : V();
+            }
+        }
+
+        template<class... A, size_t... I>
+        static std::tuple<A...> read_row(sqlite3_stmt *statement, std::index_sequence<I...>) {
+            return std::tuple<A...>(read_column<A>(statement, int(I))...);
+        }
+
+        template<class... A>
+        static std::tuple<A...> read_row(sqlite3_stmt *statement) {
+            return read_row<A...>(statement, std::index_sequence_for<A...>{});
+        }
+
+        // Mapped fields are read like those of objects, with INT columns converted
+
+        template<class V>
+        static V read_field(sqlite3_stmt *statement, int i) {
+            if constexpr (std::is_same_v<V, int>) {
+                return convert(sqlite3_column_int64(statement, i));
+            } else {
+                return read_column<V>(statement, i);
+            }
+        }
+
+        template<class... A, size_t... I>
+        static std::tuple<A...> read_fields(sqlite3_stmt *statement, std::index_sequence<I...>) {
+            return std::tuple<A...>(read_field<A>(statement, int(I))...);
+        }
+
+        static constexpr int convert(long long l) {
             if (l >> 32 > 0) {
                 return int(l / 1000);
             } else {
@@ -169,28 +438,52 @@ namespace sqlite {
 
         std::shared_ptr<T> make_object(sqlite3_stmt *statement) const {
             auto object = std::make_shared<T>();
+            fill_object(statement, *object);
+            return object;
+        }
 
-            for (int i = 0; i < m_fields.size(); ++i) {
-                const auto &f = m_fields[i];
+        // Overwrites every field, so objects can be reused for other rows. Fields are read from
+        // the columns following the offset, e.g. for rows joining several tables.
+
+        void fill_object(sqlite3_stmt *statement, T &object, int offset = 0) const {
+            fill_object(m_fields, statement, object, offset);
+        }
+
+        static void fill_object(const std::vector<sqlite::column<T>> &fields, sqlite3_stmt *statement, T &object,
+                                int offset = 0) {
+            for (int i = 0; i < fields.size(); ++i) {
+                const auto &f = fields[i];
+                const auto col = offset + i;
 
                 switch (f.get_type()) {
                     case sqlite::column<T>::type::INT: {
                         auto p = f.get_int_pointer();
-                        (*object).*p = convert(sqlite3_column_int64(statement, i));
+                        object.*p = convert(sqlite3_column_int64(statement, col));
                         break;
                     }
-                    case sqlite::column<T>::type::STRING: {
-                        auto text = (char *) sqlite3_column_text(statement, i);
+                    case sqlite::column<T>::type::STRING:
+                    case sqlite::column<T>::type::JSON: {
+                        auto text = (char *) sqlite3_column_text(statement, col);
+                        auto p = f.get_string_pointer();
                         if (text) {
-                            auto p = f.get_string_pointer();
-                            (*object).*p = text;
+                            object.*p = text;
+                        } else {
+                            (object.*p).clear();
                         }
                         break;
                     }
                 }
             }
+        }
 
-            return object;
+        // Empty JSON fields are stored as NULL, which passes the validity check
+
+        static void bind_text(sqlite3_stmt *statement, int index, const column<T> &f, const std::string &text) {
+            if (text.empty() && f.get_type() == column<T>::type::JSON) {
+                sqlite3_bind_null(statement, index);
+            } else {
+                sqlite3_bind_text(statement, index, text.c_str(), int(text.size()), SQLITE_STATIC);
+            }
         }
 
         void write_values(const std::shared_ptr<T> &object) {
@@ -210,27 +503,90 @@ namespace sqlite {
                         m_query << "'" << (*object).*p << "'";
                         break;
                     }
+                    case sqlite::column<T>::type::JSON: {
+                        auto p = f.get_string_pointer();
+                        if (((*object).*p).empty()) {
+                            m_query << "NULL";
+                        } else if (has_jsonb()) {
+                            m_query << "jsonb('" << (*object).*p << "')";
+                        } else {
+                            m_query << "'" << (*object).*p << "'";
+                        }
+                        break;
+                    }
                 }
             }
         }
 
-        void exec() {
+        bool exec() {
+            if (!m_parameters.empty()) {
+                return exec_prepared();
+            }
+
             char *error = nullptr;
-            sqlite3_exec(m_db, m_query.str().c_str(), nullptr, nullptr, &error);
+            const auto status = sqlite3_exec(m_db, m_query.str().c_str(), nullptr, nullptr, &error);
 
             if (error) {
-                m_errors.emplace_front(error);
-                if (m_errors.size() > errors_max_count) {
-                    m_errors.pop_back();
-                }
+                add_error(error);
                 sqlite3_free(error);
             }
 
             clear();
+            hooks::dispatch(m_db);
+            return status == SQLITE_OK;
+        }
+
+        // Queries with bound parameters run on cached statements
+
+        sqlite3_stmt *prepare_bound() {
+            const auto statement = statement_cache::get(m_db, m_query.str(), hooks::get_reads());
+            if (!statement) {
+                add_error(sqlite3_errmsg(m_db));
+                return nullptr;
+            }
+
+            for (size_t i = 0; i < m_parameters.size(); ++i) {
+                const auto &parameter = m_parameters[i];
+                sqlite3_bind_text(statement, int(i + 1), parameter.c_str(), int(parameter.size()), SQLITE_STATIC);
+            }
+
+            return statement;
+        }
+
+        void finish_bound(sqlite3_stmt *statement) {
+            sqlite3_reset(statement);
+            sqlite3_clear_bindings(statement);
+        }
+
+        bool exec_prepared() {
+            const auto statement = prepare_bound();
+
+            auto status = SQLITE_ERROR;
+            if (statement) {
+                while ((status = sqlite3_step(statement)) == SQLITE_ROW) {
+                }
+
+                if (status != SQLITE_DONE) {
+                    add_error(sqlite3_errmsg(m_db));
+                }
+                finish_bound(statement);
+            }
+
+            clear();
+            hooks::dispatch(m_db);
+            return status == SQLITE_DONE;
+        }
+
+        void add_error(const char *error) {
+            m_errors.emplace_front(error);
+            if (m_errors.size() > errors_max_count) {
+                m_errors.pop_back();
+            }
         }
 
         void clear() {
             m_query.str({});
+            m_parameters.clear();
             m_int_pointer = nullptr;
             m_string_pointer = nullptr;
         }
@@ -0,0 +1,81 @@
+//
+//  bound_list.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <type_traits>
+
+namespace sqlite {
+
+    // Values for IN, bound to the statement as one JSON array read with json_each(), so the
+    // query text and the cached statement don't depend on the number of values. Integers are
+    // read back as integers, so comparisons don't depend on the affinity of the other operand.
+
+    template<class C>
+    struct bound_list {
+
+        const C &values;
+
+        static constexpr bool integral = std::is_integral_v<typename C::value_type>;
+
+        std::string to_json() const {
+            std::string json = "[";
+            for (const auto &value: values) {
+                if constexpr (std::is_arithmetic_v<std::decay_t<decltype(value)>>) {
+                    json += std::to_string(value);
+                } else {
+                    append_string(json, value);
+                }
+                json += ',';
+            }
+
+            if (json.size() > 1) {
+                json.back() = ']';
+            } else {
+                json += ']';
+            }
+
+            return json;
+        }
+
+    private:
+
+        static void append_string(std::string &json, const std::string &value) {
+            json += '"';
+            for (const auto c: value) {
+                switch (c) {
+                    case '"':
+                        json += "\\\"";
+                        break;
+                    case '\\':
+                        json += "\\\\";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) {
+                            char escaped[7];
+                            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                            json += escaped;
+                        } else {
+                            json += c;
+                        }
+                        break;
+                }
+            }
+            json += '"';
+        }
+
+    };
+
+    template<class C>
+    bound_list<C> bind_list(const C &values) {
+        return {values};
+    }
+
+}
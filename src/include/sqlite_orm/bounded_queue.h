@@ -0,0 +1,108 @@
+//
+//  bounded_queue.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace sqlite {
+
+    // Lock-free multi-producer multi-consumer ring of a fixed capacity (D. Vyukov's design):
+    // every cell carries a sequence number telling whether it's ready to be written or read.
+
+    template<class T>
+    class bounded_queue {
+    public:
+
+        explicit bounded_queue(size_t capacity) {
+            m_capacity = 1;
+            while (m_capacity < capacity) {
+                m_capacity <<= 1;
+            }
+            m_mask = m_capacity - 1;
+
+            m_cells = std::make_unique<cell[]>(m_capacity);
+            for (size_t i = 0; i < m_capacity; ++i) {
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        bounded_queue(const bounded_queue &) = delete;
+
+        bounded_queue &operator=(const bounded_queue &) = delete;
+
+    public:
+
+        bool push(const T &value) {
+            auto position = m_tail.load(std::memory_order_relaxed);
+            for (;;) {
+                auto &cell = m_cells[position & m_mask];
+                const auto sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto difference = intptr_t(sequence) - intptr_t(position);
+
+                if (difference == 0) {
+                    if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        cell.value = value;
+                        cell.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool pop(T &value) {
+            auto position = m_head.load(std::memory_order_relaxed);
+            for (;;) {
+                auto &cell = m_cells[position & m_mask];
+                const auto sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto difference = intptr_t(sequence) - intptr_t(position + 1);
+
+                if (difference == 0) {
+                    if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        value = cell.value;
+                        cell.sequence.store(position + m_capacity, std::memory_order_release);
+                        return true;
+                    }
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = m_head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        size_t get_capacity() const {
+            return m_capacity;
+        }
+
+    private:
+
+        struct cell {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+    private:
+
+        size_t m_capacity;
+        size_t m_mask;
+        std::unique_ptr<cell[]> m_cells;
+
+        alignas(64) std::atomic<size_t> m_tail{0};
+        alignas(64) std::atomic<size_t> m_head{0};
+
+    };
+
+}
@@ -18,7 +18,8 @@ namespace sqlite {
 
         enum class type {
             INT,
-            STRING
+            STRING,
+            JSON
         };
 
     public:
@@ -32,6 +33,13 @@ namespace sqlite {
 
         }
 
+        // Strings holding JSON documents, declared with type::JSON
+
+        column(std::string T::* const s, const std::string &name, type t)
+                : m_pointer(s), m_name(name), m_type(t == type::JSON ? type::JSON : type::STRING) {
+
+        }
+
     public:
 
         int T::* get_int_pointer() const {
@@ -59,7 +67,7 @@ namespace sqlite {
         }
 
         bool equals(std::string T::* const pointer) const {
-            if (m_type == type::STRING) {
+            if (m_type != type::INT) {
                 return m_pointer.m_s == pointer;
             } else {
                 return false;
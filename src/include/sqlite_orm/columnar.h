@@ -0,0 +1,56 @@
+//
+//  columnar.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sqlite {
+
+    // Strings of a column stored back to back in one buffer, the i-th one spanning
+    // [offsets[i], offsets[i + 1])
+
+    struct string_column {
+
+        std::vector<uint64_t> offsets = {0};
+        std::string buffer;
+
+        size_t size() const {
+            return offsets.size() - 1;
+        }
+
+        std::string_view operator[](size_t i) const {
+            return {buffer.data() + offsets[i], size_t(offsets[i + 1] - offsets[i])};
+        }
+
+        void push_back(const char *data, size_t size) {
+            buffer.append(data, size);
+            offsets.push_back(buffer.size());
+        }
+
+    };
+
+    // Column storage by field type: a plain vector for numbers, a string_column for strings
+
+    template<class V>
+    struct columnar {
+        using type = std::vector<V>;
+    };
+
+    template<>
+    struct columnar<std::string> {
+        using type = string_column;
+    };
+
+    template<class V>
+    using columnar_t = typename columnar<V>::type;
+
+}
@@ -18,12 +18,24 @@ namespace sqlite {
         CREATE_TABLE_IF_NOT_EXISTS,
         ALTER_TABLE,
         CREATE_INDEX_IF_NOT_EXISTS,
+        CREATE_UNIQUE_INDEX_IF_NOT_EXISTS,
         INSERT_OR_REPLACE_INTO,
+        INSERT_INTO,
+        ON_CONFLICT,
+        UNIQUE_KEY,
         UPDATE,
         DELETE,
         ADD_COLUMN,
         SET,
         COUNT,
+        SUM,
+        MIN,
+        MAX,
+        AVG,
+        GROUP_BY,
+        MATCH,
+        BM25,
+        SNIPPET,
         FROM,
         WHERE,
         ORDER_BY,
@@ -39,7 +51,10 @@ namespace sqlite {
         EMPTY_STRING,
         ASC,
         DESC,
-        LIMIT
+        LIMIT,
+        BEGIN_TRANSACTION,
+        COMMIT,
+        ROLLBACK
     };
 
     static constexpr auto NONE = command::NONE;
@@ -49,12 +64,24 @@ namespace sqlite {
     static constexpr auto CREATE_TABLE_IF_NOT_EXISTS = command::CREATE_TABLE_IF_NOT_EXISTS;
     static constexpr auto ALTER_TABLE = command::ALTER_TABLE;
     static constexpr auto CREATE_INDEX_IF_NOT_EXISTS = command::CREATE_INDEX_IF_NOT_EXISTS;
+    static constexpr auto CREATE_UNIQUE_INDEX_IF_NOT_EXISTS = command::CREATE_UNIQUE_INDEX_IF_NOT_EXISTS;
     static constexpr auto INSERT_OR_REPLACE_INTO = command::INSERT_OR_REPLACE_INTO;
+    static constexpr auto INSERT_INTO = command::INSERT_INTO;
+    static constexpr auto ON_CONFLICT = command::ON_CONFLICT;
+    static constexpr auto UNIQUE_KEY = command::UNIQUE_KEY;
     static constexpr auto UPDATE = command::UPDATE;
     static constexpr auto DELETE = command::DELETE;
     static constexpr auto ADD_COLUMN = command::ADD_COLUMN;
     static constexpr auto SET = command::SET;
     static constexpr auto COUNT = command::COUNT;
+    static constexpr auto SUM = command::SUM;
+    static constexpr auto MIN = command::MIN;
+    static constexpr auto MAX = command::MAX;
+    static constexpr auto AVG = command::AVG;
+    static constexpr auto GROUP_BY = command::GROUP_BY;
+    static constexpr auto MATCH = command::MATCH;
+    static constexpr auto BM25 = command::BM25;
+    static constexpr auto SNIPPET = command::SNIPPET;
     static constexpr auto FROM = command::FROM;
     static constexpr auto WHERE = command::WHERE;
     static constexpr auto ORDER_BY = command::ORDER_BY;
@@ -71,5 +98,8 @@ namespace sqlite {
     static constexpr auto ASC = command::ASC;
     static constexpr auto DESC = command::DESC;
     static constexpr auto LIMIT = command::LIMIT;
+    static constexpr auto BEGIN_TRANSACTION = command::BEGIN_TRANSACTION;
+    static constexpr auto COMMIT = command::COMMIT;
+    static constexpr auto ROLLBACK = command::ROLLBACK;
 
 }
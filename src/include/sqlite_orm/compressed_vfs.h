@@ -0,0 +1,27 @@
+//
+//  compressed_vfs.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace sqlite {
+
+    extern const char *compressed_vfs_name;
+
+    // Read-only VFS for databases packed with pack_database(). The packed file is read through
+    // base_vfs_name (e.g. the aasset VFS), chunks are LZ4-decompressed into an LRU cache of
+    // cache_chunks entries, and the next prefetch_chunks chunks are decompressed in background.
+
+    int register_compressed_vfs(const char *name = compressed_vfs_name, const char *base_vfs_name = nullptr,
+                                size_t cache_chunks = 64, size_t prefetch_chunks = 2);
+
+    bool pack_database(const std::string &source, const std::string &destination, size_t chunk_size = 64 * 1024);
+
+}
@@ -0,0 +1,289 @@
+//
+//  container_table.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "column.h"
+#include "sqlite3.h"
+
+namespace sqlite {
+
+    // Read-only eponymous virtual table over a container of objects, with columns mapped like
+    // the fields of the database. Objects are read in place, so the container must stay alive
+    // and unchanged while it's exposed. Equality on key columns is served by hash indexes built
+    // on first use.
+
+    template<class T>
+    class container_table {
+    public:
+
+        using container = std::vector<std::shared_ptr<T>>;
+
+    public:
+
+        static int create(sqlite3 *db, const std::string &name, const std::vector<column<T>> &fields,
+                          const std::vector<size_t> &keys, const container &objects) {
+            const auto data = new container_table::data{fields, keys, &objects, {}, {}};
+            return sqlite3_create_module_v2(db, name.c_str(), &s_module, data, &destroy);
+        }
+
+    private:
+
+        struct data {
+            std::vector<column<T>> fields;
+            std::vector<size_t> keys;
+            const container *objects;
+
+            std::unordered_map<size_t, std::unordered_multimap<sqlite3_int64, size_t>> int_indexes;
+            std::unordered_map<size_t, std::unordered_multimap<std::string_view, size_t>> string_indexes;
+        };
+
+        struct table : sqlite3_vtab {
+            container_table::data *data;
+        };
+
+        struct cursor : sqlite3_vtab_cursor {
+            std::vector<size_t> matches;
+            bool indexed = false;
+            size_t position = 0;
+        };
+
+    private:
+
+        static void destroy(void *data) {
+            delete static_cast<container_table::data *>(data);
+        }
+
+        static int connect(sqlite3 *db, void *aux, int, const char *const *, sqlite3_vtab **vtab, char **) {
+            const auto data = static_cast<container_table::data *>(aux);
+
+            std::string schema = "CREATE TABLE x(";
+            for (const auto &f: data->fields) {
+                schema += f.get_name();
+                schema += f.get_type() == column<T>::type::INT ? " INTEGER," : " TEXT,";
+            }
+            schema.back() = ')';
+
+            const auto status = sqlite3_declare_vtab(db, schema.c_str());
+            if (status != SQLITE_OK) {
+                return status;
+            }
+
+            const auto result = new table();
+            result->data = data;
+            *vtab = result;
+
+            return SQLITE_OK;
+        }
+
+        static int disconnect(sqlite3_vtab *vtab) {
+            delete static_cast<table *>(vtab);
+            return SQLITE_OK;
+        }
+
+        static int best_index(sqlite3_vtab *vtab, sqlite3_index_info *info) {
+            const auto &state = *static_cast<table *>(vtab)->data;
+
+            for (int i = 0; i < info->nConstraint; ++i) {
+                const auto &constraint = info->aConstraint[i];
+                if (!constraint.usable || constraint.op != SQLITE_INDEX_CONSTRAINT_EQ || constraint.iColumn < 0) {
+                    continue;
+                }
+
+                const auto key = size_t(constraint.iColumn);
+                if (std::find(state.keys.begin(), state.keys.end(), key) == state.keys.end()) {
+                    continue;
+                }
+
+                // Hash indexes only compare with the binary collation
+
+                const auto collation = sqlite3_vtab_collation(info, i);
+                if (collation && sqlite3_stricmp(collation, "BINARY") != 0) {
+                    continue;
+                }
+
+                // The type of the argument isn't known yet, so SQLite still checks the constraint
+                // on the rows found by filter()
+
+                info->aConstraintUsage[i].argvIndex = 1;
+                info->aConstraintUsage[i].omit = 0;
+                info->idxNum = int(key) + 1;
+                info->estimatedCost = 1;
+                info->estimatedRows = 1;
+                return SQLITE_OK;
+            }
+
+            info->idxNum = 0;
+            info->estimatedCost = double(state.objects->size());
+            info->estimatedRows = sqlite3_int64(state.objects->size());
+            return SQLITE_OK;
+        }
+
+        static int open(sqlite3_vtab *, sqlite3_vtab_cursor **result) {
+            *result = new cursor();
+            return SQLITE_OK;
+        }
+
+        static int close(sqlite3_vtab_cursor *cursor) {
+            delete static_cast<container_table::cursor *>(cursor);
+            return SQLITE_OK;
+        }
+
+        static int filter(sqlite3_vtab_cursor *base, int index, const char *, int argc, sqlite3_value **argv) {
+            auto &cursor = *static_cast<container_table::cursor *>(base);
+            auto &state = *static_cast<table *>(base->pVtab)->data;
+
+            cursor.position = 0;
+            cursor.matches.clear();
+            cursor.indexed = index > 0 && argc > 0;
+
+            if (!cursor.indexed) {
+                return SQLITE_OK;
+            }
+
+            // Arguments are converted with the affinity of the column, as SQLite compares them;
+            // those that can't equal any value of the column match nothing
+
+            const auto key = size_t(index - 1);
+            const auto value = argv[0];
+            if (state.fields[key].get_type() == column<T>::type::INT) {
+                sqlite3_int64 number;
+                switch (sqlite3_value_numeric_type(value)) {
+                    case SQLITE_INTEGER:
+                        number = sqlite3_value_int64(value);
+                        break;
+                    case SQLITE_FLOAT: {
+                        const auto real = sqlite3_value_double(value);
+                        if (std::floor(real) != real || std::fabs(real) > 9.0e18) {
+                            return SQLITE_OK;
+                        }
+                        number = sqlite3_int64(real);
+                        break;
+                    }
+                    default:
+                        return SQLITE_OK;
+                }
+
+                const auto &map = get_int_index(state, key);
+                const auto range = map.equal_range(number);
+                for (auto it = range.first; it != range.second; ++it) {
+                    cursor.matches.push_back(it->second);
+                }
+            } else {
+                const auto type = sqlite3_value_type(value);
+                if (type == SQLITE_NULL || type == SQLITE_BLOB) {
+                    return SQLITE_OK;
+                }
+
+                const auto text = reinterpret_cast<const char *>(sqlite3_value_text(value));
+                const std::string_view string(text ? text : "", size_t(sqlite3_value_bytes(value)));
+                const auto &map = get_string_index(state, key);
+                const auto range = map.equal_range(string);
+                for (auto it = range.first; it != range.second; ++it) {
+                    cursor.matches.push_back(it->second);
+                }
+            }
+
+            return SQLITE_OK;
+        }
+
+        static int next(sqlite3_vtab_cursor *base) {
+            ++static_cast<container_table::cursor *>(base)->position;
+            return SQLITE_OK;
+        }
+
+        static int eof(sqlite3_vtab_cursor *base) {
+            const auto &cursor = *static_cast<container_table::cursor *>(base);
+            const auto &state = *static_cast<table *>(base->pVtab)->data;
+
+            return cursor.indexed ? cursor.position >= cursor.matches.size()
+                                  : cursor.position >= state.objects->size();
+        }
+
+        static int get_column(sqlite3_vtab_cursor *base, sqlite3_context *context, int i) {
+            const auto &state = *static_cast<table *>(base->pVtab)->data;
+            const auto &object = *(*state.objects)[get_row(base)];
+            const auto &f = state.fields[size_t(i)];
+
+            switch (f.get_type()) {
+                case column<T>::type::INT:
+                    sqlite3_result_int(context, object.*f.get_int_pointer());
+                    break;
+                case column<T>::type::STRING:
+                case column<T>::type::JSON: {
+                    const auto &text = object.*f.get_string_pointer();
+                    sqlite3_result_text(context, text.c_str(), int(text.size()), SQLITE_STATIC);
+                    break;
+                }
+            }
+
+            return SQLITE_OK;
+        }
+
+        static int get_rowid(sqlite3_vtab_cursor *base, sqlite3_int64 *rowid) {
+            *rowid = sqlite3_int64(get_row(base));
+            return SQLITE_OK;
+        }
+
+        static size_t get_row(sqlite3_vtab_cursor *base) {
+            const auto &cursor = *static_cast<container_table::cursor *>(base);
+            return cursor.indexed ? cursor.matches[cursor.position] : cursor.position;
+        }
+
+        static const std::unordered_multimap<sqlite3_int64, size_t> &get_int_index(data &state, size_t key) {
+            auto &index = state.int_indexes[key];
+            if (index.empty()) {
+                const auto p = state.fields[key].get_int_pointer();
+                for (size_t i = 0; i < state.objects->size(); ++i) {
+                    index.emplace((*(*state.objects)[i]).*p, i);
+                }
+            }
+            return index;
+        }
+
+        static const std::unordered_multimap<std::string_view, size_t> &get_string_index(data &state, size_t key) {
+            auto &index = state.string_indexes[key];
+            if (index.empty()) {
+                const auto p = state.fields[key].get_string_pointer();
+                for (size_t i = 0; i < state.objects->size(); ++i) {
+                    index.emplace((*(*state.objects)[i]).*p, i);
+                }
+            }
+            return index;
+        }
+
+    private:
+
+        static sqlite3_module make_module() {
+            sqlite3_module module{};
+            module.xConnect = &connect;
+            module.xBestIndex = &best_index;
+            module.xDisconnect = &disconnect;
+            module.xOpen = &open;
+            module.xClose = &close;
+            module.xFilter = &filter;
+            module.xNext = &next;
+            module.xEof = &eof;
+            module.xColumn = &get_column;
+            module.xRowid = &get_rowid;
+            return module;
+        }
+
+        static inline sqlite3_module s_module = make_module();
+
+    };
+
+}
@@ -0,0 +1,131 @@
+//
+//  data_version_watcher.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "sqlite3.h"
+
+namespace sqlite {
+
+    // Polls PRAGMA data_version on its own connection, which sees commits of every other
+    // connection to the file, including ones from other processes, and calls back on change.
+
+    class data_version_watcher {
+    public:
+
+        using callback = std::function<void()>;
+
+    public:
+
+        data_version_watcher(sqlite3 *const db, std::chrono::milliseconds interval, const callback &callback) :
+                m_interval(interval), m_callback(callback) {
+            const auto filename = sqlite3_db_filename(db, "main");
+            if (filename && *filename) {
+                sqlite3_vfs *vfs = nullptr;
+                sqlite3_file_control(db, "main", SQLITE_FCNTL_VFS_POINTER, &vfs);
+
+                const auto vfs_name = vfs ? vfs->zName : nullptr;
+                if (sqlite3_open_v2(filename, &m_db, SQLITE_OPEN_READONLY, vfs_name) != SQLITE_OK) {
+                    sqlite3_close(m_db);
+                    m_db = nullptr;
+                }
+            }
+
+            if (m_db) {
+                m_version = get_version();
+                m_thread = std::thread(&data_version_watcher::run, this);
+            }
+        }
+
+        ~data_version_watcher() {
+            stop();
+            sqlite3_close(m_db);
+        }
+
+        data_version_watcher(const data_version_watcher &) = delete;
+
+        data_version_watcher &operator=(const data_version_watcher &) = delete;
+
+    public:
+
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopped = true;
+                m_condition.notify_all();
+            }
+
+            if (m_thread.joinable()) {
+                m_thread.join();
+            }
+        }
+
+        bool is_watching() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_db && !m_stopped;
+        }
+
+    private:
+
+        const std::chrono::milliseconds m_interval;
+        const callback m_callback;
+
+        sqlite3 *m_db = nullptr;
+        int64_t m_version = 0;
+
+        std::thread m_thread;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_stopped = false;
+
+    private:
+
+        void run() {
+            while (sleep()) {
+                const auto version = get_version();
+                if (version >= 0 && version != m_version) {
+                    m_version = version;
+
+                    if (m_callback) {
+                        m_callback();
+                    }
+                }
+            }
+        }
+
+        bool sleep() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait_for(lock, m_interval, [this] { return m_stopped; });
+            return !m_stopped;
+        }
+
+        int64_t get_version() const {
+            sqlite3_stmt *statement;
+            if (sqlite3_prepare_v2(m_db, "PRAGMA data_version", -1, &statement, nullptr) != SQLITE_OK) {
+                return -1;
+            }
+
+            int64_t version = -1;
+            if (sqlite3_step(statement) == SQLITE_ROW) {
+                version = sqlite3_column_int64(statement, 0);
+            }
+
+            sqlite3_finalize(statement);
+            return version;
+        }
+
+    };
+
+}
@@ -8,17 +8,38 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "base_database.h"
+#include "bound_list.h"
+#include "columnar.h"
 #include "commands.h"
+#include "container_table.h"
+#include "functions.h"
 #include "column.h"
+#include "hooks.h"
+#include "identity_map.h"
+#include "json_path.h"
+#include "paginator.h"
+#include "pipeline.h"
+#include "query_cache.h"
+#include "read_pool.h"
+#include "read_snapshot.h"
+#include "statement_cache.h"
+#include "subscription.h"
+#include "tracked.h"
 #include "sqlite3.h"
 
 namespace sqlite {
@@ -49,17 +70,68 @@ namespace sqlite {
             return db;
         }
 
+        static sqlite3 *open_snapshot(const std::string &path, const char *vfs) {
+            sqlite3 *source = nullptr;
+            sqlite3_open_v2(path.c_str(), &source, SQLITE_OPEN_READONLY, vfs);
+
+            sqlite3_int64 size = 0;
+            const auto data = sqlite3_serialize(source, "main", &size, 0);
+            sqlite3_close(source);
+
+            if (!data) {
+                return nullptr;
+            }
+
+            // A WAL file format marker would make the in-memory database look for a -wal file
+
+            if (size > 19 && data[18] == 2) {
+                data[18] = 1;
+                data[19] = 1;
+            }
+
+            sqlite3 *db = nullptr;
+            sqlite3_open_v2(":memory:", &db, SQLITE_OPEN_READWRITE, nullptr);
+
+            const auto flags = SQLITE_DESERIALIZE_FREEONCLOSE | SQLITE_DESERIALIZE_RESIZEABLE;
+            if (sqlite3_deserialize(db, "main", data, size, size, flags) != SQLITE_OK) {
+                sqlite3_close(db);
+                return nullptr;
+            }
+
+            // Databases already open on the path keep their connection, which is closed by clear()
+
+            auto &cached = s_cache[path];
+            if (cached) {
+                s_replaced.push_back(cached);
+            }
+            cached = db;
+
+            return db;
+        }
+
         static void clear() {
             for (const auto &[path, db] : s_cache) {
-                if (db) {
-                    sqlite3_close(db);
-                }
+                close(db);
             }
             s_cache.clear();
+
+            for (const auto db: s_replaced) {
+                close(db);
+            }
+            s_replaced.clear();
         }
 
     private:
         static inline std::unordered_map<std::string, sqlite3 *> s_cache;
+        static inline std::vector<sqlite3 *> s_replaced;
+
+        static void close(sqlite3 *db) {
+            if (db) {
+                hooks::release(db);
+                statement_cache::release(db);
+                sqlite3_close(db);
+            }
+        }
 
     };
 
@@ -74,6 +146,9 @@ namespace sqlite {
 
         using base = base_database<T>;
 
+        template<class>
+        friend class database;
+
     public:
 
         static std::shared_ptr<sqlite::database<T>>
@@ -86,6 +161,20 @@ namespace sqlite {
             return open(path, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, vfs_name);
         }
 
+        static std::shared_ptr<sqlite::database<T>>
+        open_in_memory_snapshot(const std::string &path, const std::string &vfs_name = {}) {
+            const auto c_vfs_name = vfs_name.empty() ? nullptr : vfs_name.c_str();
+            if (const auto db = db_cache::open_snapshot(path, c_vfs_name)) {
+                return std::make_shared<sqlite::database<T>>(db);
+            }
+
+            // Without a snapshot, e.g. for a missing file, the file is opened read-only instead
+
+            const auto db = open_read_only(path, vfs_name);
+            db->add_error(("can't take a snapshot of " + path).c_str());
+            return db;
+        }
+
         static void clear_cache() {
             db_cache::clear();
         }
@@ -94,6 +183,18 @@ namespace sqlite {
 
         explicit database(sqlite3 *db) : base(db) {}
 
+        ~database() {
+            for (const auto &[table, identity_map]: m_identity_maps) {
+                hooks::remove_listener(base::m_db, identity_map.second);
+            }
+
+            disable_query_cache();
+
+            for (const auto id: m_subscriptions) {
+                hooks::remove_listener(base::m_db, id);
+            }
+        }
+
     public:
 
         // Mutex
@@ -132,10 +233,15 @@ namespace sqlite {
                     case command::CREATE_TABLE_IF_NOT_EXISTS:
                     case command::ALTER_TABLE:
                     case command::CREATE_INDEX_IF_NOT_EXISTS:
+                    case command::CREATE_UNIQUE_INDEX_IF_NOT_EXISTS:
                     case command::INSERT_OR_REPLACE_INTO:
+                    case command::INSERT_INTO:
                     case command::UPDATE:
                     case command::DELETE:
-                        base::exec();
+                    case command::BEGIN_TRANSACTION:
+                    case command::COMMIT:
+                    case command::ROLLBACK:
+                        m_succeeded = base::exec();
                         break;
                     default:
                         break;
@@ -186,10 +292,24 @@ namespace sqlite {
                     base::m_query << "CREATE INDEX IF NOT EXISTS ";
                     m_active_command = command::CREATE_INDEX_IF_NOT_EXISTS;
                     break;
+                case command::CREATE_UNIQUE_INDEX_IF_NOT_EXISTS:
+                    base::m_query << "CREATE UNIQUE INDEX IF NOT EXISTS ";
+                    m_active_command = command::CREATE_UNIQUE_INDEX_IF_NOT_EXISTS;
+                    break;
                 case command::INSERT_OR_REPLACE_INTO:
                     base::m_query << "INSERT OR REPLACE INTO ";
                     m_active_command = command::INSERT_OR_REPLACE_INTO;
                     break;
+                case command::INSERT_INTO:
+                    base::m_query << "INSERT INTO ";
+                    m_active_command = command::INSERT_INTO;
+                    break;
+                case command::ON_CONFLICT:
+                    base::m_query << base::get_upsert_clause() << " ";
+                    break;
+                case command::UNIQUE_KEY:
+                    base::m_query << base::get_unique_key() << " ";
+                    break;
                 case command::UPDATE:
                     base::m_query << "UPDATE ";
                     m_active_command = command::UPDATE;
@@ -207,6 +327,30 @@ namespace sqlite {
                 case command::COUNT:
                     base::m_query << "COUNT(*) ";
                     break;
+                case command::SUM:
+                    base::m_query << "SUM";
+                    break;
+                case command::MIN:
+                    base::m_query << "MIN";
+                    break;
+                case command::MAX:
+                    base::m_query << "MAX";
+                    break;
+                case command::AVG:
+                    base::m_query << "AVG";
+                    break;
+                case command::GROUP_BY:
+                    base::m_query << "GROUP BY ";
+                    break;
+                case command::MATCH:
+                    base::m_query << "MATCH ";
+                    break;
+                case command::BM25:
+                    base::m_query << "bm25";
+                    break;
+                case command::SNIPPET:
+                    base::m_query << "snippet";
+                    break;
                 case command::FROM:
                     base::m_query << "FROM ";
                     break;
@@ -219,8 +363,11 @@ namespace sqlite {
                 case command::ALL:
                     if (m_active_command == command::CREATE_TABLE_IF_NOT_EXISTS) {
                         base::m_query << base::m_all_fields_with_types << " ";
-                    } else {
+                    } else if (m_active_command == command::INSERT_OR_REPLACE_INTO ||
+                               m_active_command == command::INSERT_INTO) {
                         base::m_query << base::m_all_fields << " ";
+                    } else {
+                        base::m_query << base::m_selected_fields << " ";
                     }
                     break;
                 case command::VALUES:
@@ -259,6 +406,18 @@ namespace sqlite {
                 case command::LIMIT:
                     base::m_query << "LIMIT ";
                     break;
+                case command::BEGIN_TRANSACTION:
+                    base::m_query << "BEGIN TRANSACTION ";
+                    m_active_command = command::BEGIN_TRANSACTION;
+                    break;
+                case command::COMMIT:
+                    base::m_query << "COMMIT ";
+                    m_active_command = command::COMMIT;
+                    break;
+                case command::ROLLBACK:
+                    base::m_query << "ROLLBACK ";
+                    m_active_command = command::ROLLBACK;
+                    break;
                 default:
                     break;
             }
@@ -329,6 +488,33 @@ namespace sqlite {
             return *this;
         }
 
+        template<class C>
+        database &operator<<(const bound_list<C> &list) {
+            if constexpr (bound_list<C>::integral) {
+                base::m_query << "(SELECT CAST(value AS INTEGER) FROM json_each(?)) ";
+            } else {
+                base::m_query << "(SELECT value FROM json_each(?)) ";
+            }
+            base::m_parameters.push_back(list.to_json());
+
+            return *this;
+        }
+
+        database &operator<<(const json_path<T> &json_path) {
+            const auto &paths = base::m_json_paths;
+            const auto it = std::find_if(paths.begin(), paths.end(), [&json_path](const auto &column) {
+                return column.field == json_path.field && column.path == json_path.path && !column.missing;
+            });
+
+            if (it != paths.end()) {
+                base::m_query << it->name << " ";
+            } else {
+                base::m_query << base::get_json_extract(json_path.field, json_path.path) << " ";
+            }
+
+            return *this;
+        }
+
         database &operator<<(const std::unordered_set<int> &values) {
             base::m_query << "(";
             size_t counter = 0;
@@ -364,15 +550,32 @@ namespace sqlite {
 
         template<class V>
         operator V() {
-            V value = 0;
+            V value{};
             *this >> value;
             return value;
         }
 
         template<class V>
         void operator>>(V &value) {
-            base::iterate([&](sqlite3_stmt *const statement) {
-                value = sqlite3_column_int(statement, 0);
+            fetch(value, [](auto &result, sqlite3_stmt *const statement) {
+                result = base::template read_column<V>(statement, 0);
+            });
+        }
+
+        // Pairs of the first two columns, e.g. a group and its aggregate
+
+        template<class K, class V>
+        void operator>>(std::unordered_map<K, V> &container) {
+            fetch(container, [](auto &result, sqlite3_stmt *const statement) {
+                result.emplace(base::template read_column<K>(statement, 0),
+                               base::template read_column<V>(statement, 1));
+            });
+        }
+
+        template<class... A>
+        void operator>>(std::vector<std::tuple<A...>> &container) {
+            fetch(container, [](auto &result, sqlite3_stmt *const statement) {
+                result.emplace_back(base::template read_row<A...>(statement));
             });
         }
 
@@ -385,9 +588,9 @@ namespace sqlite {
 
         template<class V>
         void operator>>(std::unordered_map<V, std::shared_ptr<T>> &container) {
-            base::iterate([&](sqlite3_stmt *const statement) {
+            fetch(container, [this](auto &result, sqlite3_stmt *const statement) {
                 const auto key = base::get(base::m_int_pointer, statement);
-                container.emplace(key, base::make_object(statement));
+                result.emplace(key, base::make_object(statement));
             });
         }
 
@@ -398,9 +601,9 @@ namespace sqlite {
         }
 
         void operator>>(std::unordered_map<std::string, std::shared_ptr<T>> &container) {
-            base::iterate([&](sqlite3_stmt *const statement) {
+            fetch(container, [this](auto &result, sqlite3_stmt *const statement) {
                 const auto key = base::get(base::m_string_pointer, statement);
-                container.emplace(key, base::make_object(statement));
+                result.emplace(key, base::make_object(statement));
             });
         }
 
@@ -413,9 +616,9 @@ namespace sqlite {
 
         template<class V>
         void operator>>(std::unordered_set<V> &container) {
-            base::iterate([&](sqlite3_stmt *const statement) {
+            fetch(container, [this](auto &result, sqlite3_stmt *const statement) {
                 const auto value = base::get(base::m_int_pointer, statement);
-                container.emplace(value);
+                result.emplace(value);
             });
         }
 
@@ -426,9 +629,9 @@ namespace sqlite {
         }
 
         void operator>>(std::unordered_set<std::string> &container) {
-            base::iterate([&](sqlite3_stmt *const statement) {
+            fetch(container, [this](auto &result, sqlite3_stmt *const statement) {
                 const auto value = base::get(base::m_string_pointer, statement);
-                container.emplace(value);
+                result.emplace(value);
             });
         }
 
@@ -439,8 +642,8 @@ namespace sqlite {
         }
 
         void operator>>(std::unordered_set<std::shared_ptr<T>> &container) {
-            base::iterate([&](sqlite3_stmt *const statement) {
-                container.emplace(base::make_object(statement));
+            fetch(container, [this](auto &result, sqlite3_stmt *const statement) {
+                result.emplace(base::make_object(statement));
             });
         }
 
@@ -453,9 +656,9 @@ namespace sqlite {
 
         template<class V>
         void operator>>(std::vector<V> &container) {
-            base::iterate([&](sqlite3_stmt *const statement) {
+            fetch(container, [this](auto &result, sqlite3_stmt *const statement) {
                 const auto value = base::get(base::m_int_pointer, statement);
-                container.emplace_back(value);
+                result.emplace_back(value);
             });
         }
 
@@ -466,9 +669,9 @@ namespace sqlite {
         }
 
         void operator>>(std::vector<std::string> &container) {
-            base::iterate([&](sqlite3_stmt *const statement) {
+            fetch(container, [this](auto &result, sqlite3_stmt *const statement) {
                 const auto value = base::get(base::m_string_pointer, statement);
-                container.emplace_back(value);
+                result.emplace_back(value);
             });
         }
 
@@ -479,13 +682,21 @@ namespace sqlite {
         }
 
         void operator>>(std::vector<std::shared_ptr<T>> &container) {
-            base::iterate([&](sqlite3_stmt *const statement) {
-                container.emplace_back(base::make_object(statement));
+            fetch(container, [this](auto &result, sqlite3_stmt *const statement) {
+                result.emplace_back(base::make_object(statement));
             });
         }
 
         void ensure_fields(const std::string &table) {
-            *this << PRAGMA << TABLE_INFO << '(' << table << ')' << ';';
+            if (get_fingerprint(table) == base::m_fingerprint) {
+                return;
+            }
+
+            //
+
+            // Unlike table_info, table_xinfo lists generated columns too
+
+            *this << PRAGMA << "table_xinfo" << '(' << table << ')' << ';';
 
             std::unordered_set<std::string> current_fields;
             const bool success = base::iterate([&](sqlite3_stmt *const statement) {
@@ -496,21 +707,833 @@ namespace sqlite {
                 return;
             }
 
+            //
+
+            const bool own_transaction = sqlite3_get_autocommit(base::m_db);
+            if (own_transaction) {
+                *this << BEGIN_TRANSACTION << ';';
+                if (!m_succeeded) {
+                    return;
+                }
+            }
+
+            bool altered = true;
             for (const auto &field: base::m_fields) {
-                if (!current_fields.count(field.get_name())) {
-                    add_field(table, field);
+                if (altered && !current_fields.count(field.get_name())) {
+                    altered = add_field(table, field);
+                }
+            }
+
+            // SQLite can't add stored columns to existing tables, so only virtual ones are added.
+            // Missing paths are read with json_extract(), and the schema is checked again next time.
+
+            bool complete = true;
+            for (auto &json_path: base::m_json_paths) {
+                if (!altered || current_fields.count(json_path.name)) {
+                    continue;
+                }
+
+                if (json_path.stored) {
+                    base::add_error(("stored column " + json_path.name + " can't be added to " + table).c_str());
+                    json_path.missing = true;
+                    complete = false;
+                } else {
+                    *this << ALTER_TABLE << table << ADD_COLUMN << json_path.declaration.c_str() << ';';
+                    altered = m_succeeded;
                 }
             }
+
+            // A read-only database with a complete schema is checked again on every start
+
+            if (altered && complete && !sqlite3_db_readonly(base::m_db, "main")) {
+                set_fingerprint(table);
+            }
+
+            if (own_transaction) {
+                *this << (altered ? COMMIT : ROLLBACK) << ';';
+            }
+        }
+
+        bool add_field(const std::string &table, const sqlite::column<T> &field) {
+            *this << ALTER_TABLE << table << ADD_COLUMN << base::get_declaration(field).c_str() << ';';
+            return m_succeeded;
+        }
+
+        // Identity map
+
+        void enable_identity_map(const std::string &table, size_t capacity = 1024, bool weak = false) {
+            disable_identity_map(table);
+
+            const auto identity_map = std::make_shared<sqlite::identity_map<T>>(capacity, weak);
+
+            // Rows deleted by REPLACE on a unique key other than the id aren't reported by the update
+            // hook, so an insert into such a table drops every object. Unique indexes are checked here.
+            const bool replaces = has_unique_index(table);
+
+            hooks::listener listener;
+            listener.on_update = [identity_map, table, replaces](int operation, const char *changed_table,
+                                                                 sqlite3_int64 rowid) {
+                if (sqlite3_stricmp(changed_table, table.c_str()) == 0) {
+                    if (replaces && operation == SQLITE_INSERT) {
+                        identity_map->clear();
+                    } else {
+                        identity_map->erase(rowid);
+                    }
+                }
+            };
+            listener.on_transaction = [identity_map](bool committed) {
+                if (!committed) {
+                    identity_map->clear();
+                }
+            };
+
+            m_identity_maps.emplace(table, std::make_pair(identity_map, hooks::add_listener(base::m_db, listener)));
+        }
+
+        void disable_identity_map(const std::string &table) {
+            const auto it = m_identity_maps.find(table);
+            if (it != m_identity_maps.end()) {
+                hooks::remove_listener(base::m_db, it->second.second);
+                m_identity_maps.erase(it);
+            }
+        }
+
+        std::shared_ptr<T> find_by_id(const std::string &table, int id) {
+            const auto it = m_identity_maps.find(table);
+            const auto identity_map = it == m_identity_maps.end() ? nullptr : it->second.first;
+
+            size_t version = 0;
+            if (identity_map) {
+                if (auto object = identity_map->find(id)) {
+                    return object;
+                }
+                version = identity_map->get_version();
+            }
+
+            *this << SELECT << ALL << FROM << table
+                  << WHERE << base::m_fields.front().get_name().c_str() << EQUALS << id;
+
+            std::shared_ptr<T> object;
+            base::iterate([&](sqlite3_stmt *const statement) {
+                object = base::make_object(statement);
+            });
+
+            if (object && identity_map) {
+                identity_map->put(id, object, version);
+            }
+
+            return object;
         }
 
-        void add_field(const std::string &table, const sqlite::column<T> &field) {
-            *this << ALTER_TABLE << table << ADD_COLUMN << field.get_name() << base::to_string(field.get_type()) << ';';
+        // Query cache. Results of getters are kept by query text and dropped when a table they read
+        // is changed through this connection; objects in cached results are shared between readers.
+
+        void enable_query_cache(size_t capacity = 128,
+                                std::chrono::milliseconds ttl = std::chrono::milliseconds(60 * 1000)) {
+            disable_query_cache();
+
+            const auto query_cache = std::make_shared<sqlite::query_cache>(capacity, ttl);
+            hooks::listener listener;
+            listener.on_update = [query_cache](int, const char *table, sqlite3_int64) {
+                query_cache->invalidate(table);
+            };
+            listener.on_transaction = [query_cache](bool committed) {
+                if (!committed) {
+                    query_cache->clear();
+                }
+            };
+            m_query_cache_listener = hooks::add_listener(base::m_db, listener);
+
+            m_query_cache = query_cache;
+        }
+
+        void disable_query_cache() {
+            if (m_query_cache) {
+                hooks::remove_listener(base::m_db, m_query_cache_listener);
+                m_query_cache = nullptr;
+            }
+        }
+
+        query_cache::statistics get_query_cache_statistics() const {
+            return m_query_cache ? m_query_cache->get_statistics() : query_cache::statistics{};
+        }
+
+        // Subscriptions. Changes of the table are delivered once per committed transaction, after
+        // the statement that committed it has finished, so subscribers may use the database.
+
+        using subscriber = std::function<void(const sqlite::changes<T> &)>;
+
+        size_t subscribe(const std::string &table, const subscriber &subscriber, bool with_objects = false) {
+            const auto tracker = std::make_shared<change_tracker>();
+
+            hooks::listener listener;
+            listener.on_update = [tracker, table](int operation, const char *changed_table, sqlite3_int64 rowid) {
+                if (sqlite3_stricmp(changed_table, table.c_str()) == 0) {
+                    tracker->on_update(operation, rowid);
+                }
+            };
+            listener.on_transaction = [tracker](bool committed) {
+                tracker->on_transaction(committed);
+            };
+            listener.on_idle = [this, tracker, table, subscriber, with_objects] {
+                for (auto &changes: tracker->take<T>()) {
+                    if (with_objects) {
+                        load_objects(table, changes.inserted, changes.objects);
+                        load_objects(table, changes.updated, changes.objects);
+                    }
+
+                    subscriber(changes);
+                }
+            };
+
+            const auto id = hooks::add_listener(base::m_db, listener);
+            m_subscriptions.insert(id);
+            return id;
+        }
+
+        void unsubscribe(size_t id) {
+            if (m_subscriptions.erase(id)) {
+                hooks::remove_listener(base::m_db, id);
+            }
+        }
+
+        // Keyset pagination over the rows of the built query, which must select ALL. The id is
+        // appended to the keys when missing, so that rows with equal keys aren't skipped.
+
+        template<class... K>
+        std::shared_ptr<sqlite::paginator<T>> paginate(int page_size, K T::* const ... keys) {
+            std::vector<sqlite::column<T>> columns;
+            std::vector<int> positions;
+            const auto add = [this, &columns, &positions](const auto key) {
+                const auto it = base::find(key);
+                if (it != base::m_fields.end()) {
+                    columns.push_back(*it);
+                    positions.push_back(int(it - base::m_fields.begin()));
+                }
+            };
+            (add(keys), ...);
+
+            if (std::find(positions.begin(), positions.end(), 0) == positions.end()) {
+                columns.push_back(base::m_fields.front());
+                positions.push_back(0);
+            }
+
+            const auto query = base::get_query();
+            base::clear();
+
+            // The decoder keeps its own copy of the fields, since the paginator may outlive this object
+
+            return std::make_shared<sqlite::paginator<T>>(
+                    base::m_db, query, columns, positions, page_size,
+                    [fields = base::m_fields](sqlite3_stmt *const statement) {
+                        auto object = std::make_shared<T>();
+                        base::fill_object(fields, statement, *object);
+                        return object;
+                    });
+        }
+
+        // Parallel scans. The rowid range of the table is split into partitions, each one read on
+        // its own thread and pooled read-only connection; without a file it's read in one go.
+        // With snapshot support in WAL mode all partitions read the same commit.
+
+        std::vector<std::vector<std::shared_ptr<T>>> scan_partitions(const std::string &table, size_t partitions = 0) {
+            if (partitions == 0) {
+                partitions = std::max(1u, std::thread::hardware_concurrency());
+            }
+
+            sqlite3_int64 first = 0;
+            sqlite3_int64 last = -1;
+
+            sqlite3_stmt *statement;
+            const auto range_query = "SELECT min(rowid), max(rowid) FROM " + table;
+            if (sqlite3_prepare_v2(base::m_db, range_query.c_str(), -1, &statement, nullptr) == SQLITE_OK) {
+                if (sqlite3_step(statement) == SQLITE_ROW && sqlite3_column_type(statement, 0) != SQLITE_NULL) {
+                    first = sqlite3_column_int64(statement, 0);
+                    last = sqlite3_column_int64(statement, 1);
+                }
+                sqlite3_finalize(statement);
+            }
+
+            if (last < first) {
+                return {};
+            }
+
+            if (!m_read_pool) {
+                m_read_pool = std::make_unique<read_pool>(base::m_db);
+            }
+
+            if (!m_read_pool->is_available()) {
+                partitions = 1;
+            }
+
+            const auto count = uint64_t(last - first) + 1;
+            partitions = size_t(std::min<uint64_t>(partitions, count));
+            const auto step = (count + partitions - 1) / partitions;
+
+            std::vector<std::vector<std::shared_ptr<T>>> result(partitions);
+            std::vector<sqlite3 *> connections(partitions, nullptr);
+            for (auto &connection: connections) {
+                connection = m_read_pool->acquire();
+            }
+
+            // Partitions see the same commit when snapshots are supported
+
+            std::unique_ptr<read_snapshot> snapshot;
+            std::vector<bool> opened(partitions, false);
+            if (partitions > 1 && connections.front()) {
+                snapshot = std::make_unique<read_snapshot>(connections.front());
+                for (size_t i = 1; i < partitions && snapshot->is_valid(); ++i) {
+                    opened[i] = connections[i] && snapshot->open(connections[i]);
+                }
+            }
+
+            const auto query = "SELECT " + base::m_selected_fields + " FROM " + table + " WHERE rowid BETWEEN ? AND ?";
+            const auto scan = [&](size_t i) {
+                const auto db = connections[i] ? connections[i] : base::m_db;
+                const auto low = first + sqlite3_int64(i * step);
+                const auto high = i + 1 == partitions ? last : low + sqlite3_int64(step) - 1;
+
+                sqlite3_stmt *statement;
+                if (sqlite3_prepare_v2(db, query.c_str(), -1, &statement, nullptr) != SQLITE_OK) {
+                    return;
+                }
+
+                sqlite3_bind_int64(statement, 1, low);
+                sqlite3_bind_int64(statement, 2, high);
+
+                auto &objects = result[i];
+                while (sqlite3_step(statement) == SQLITE_ROW) {
+                    objects.push_back(base::make_object(statement));
+                }
+
+                sqlite3_finalize(statement);
+            };
+
+            std::vector<std::thread> threads;
+            for (size_t i = 1; i < partitions; ++i) {
+                threads.emplace_back(scan, i);
+            }
+            scan(0);
+
+            for (auto &thread: threads) {
+                thread.join();
+            }
+
+            for (size_t i = 1; i < partitions; ++i) {
+                if (opened[i]) {
+                    read_snapshot::close(connections[i]);
+                }
+            }
+            snapshot = nullptr;
+
+            for (const auto connection: connections) {
+                m_read_pool->release(connection);
+            }
+
+            return result;
+        }
+
+        void parallel_select(const std::string &table, std::vector<std::shared_ptr<T>> &container,
+                             size_t partitions = 0) {
+            auto result = scan_partitions(table, partitions);
+
+            size_t size = container.size();
+            for (const auto &objects: result) {
+                size += objects.size();
+            }
+            container.reserve(size);
+
+            for (auto &objects: result) {
+                std::move(objects.begin(), objects.end(), std::back_inserter(container));
+            }
+        }
+
+        // Pipelined reading of the built query: rows are stepped and decoded on this thread and
+        // consumed on the workers. The consumer is called concurrently, with objects that are
+        // only valid during the call.
+
+        bool consume_parallel(const typename sqlite::pipeline<T>::consumer &consumer, size_t workers = 0,
+                              size_t batch_size = 256, size_t depth = 4) {
+            if (workers == 0) {
+                workers = std::max(2u, std::thread::hardware_concurrency()) - 1;
+            }
+
+            sqlite::pipeline<T> pipeline(workers, batch_size, depth, consumer);
+            const auto success = base::iterate([&](sqlite3_stmt *const statement) {
+                base::fill_object(statement, pipeline.next());
+            });
+            pipeline.finish();
+
+            return success;
+        }
+
+        // Dirty tracking. Only the changed fields of a tracked object are written, with a statement
+        // prepared once per table and set of changed fields.
+
+        sqlite::tracked<T> track(const std::shared_ptr<T> &object) const {
+            return sqlite::tracked<T>(object);
+        }
+
+        std::vector<size_t> get_dirty_fields(const sqlite::tracked<T> &object) const {
+            std::vector<size_t> dirty_fields;
+            for (size_t i = 1; i < base::m_fields.size(); ++i) {
+                const auto &f = base::m_fields[i];
+
+                switch (f.get_type()) {
+                    case sqlite::column<T>::type::INT: {
+                        const auto p = f.get_int_pointer();
+                        if ((*object).*p != object.get_original().*p) {
+                            dirty_fields.push_back(i);
+                        }
+                        break;
+                    }
+                    case sqlite::column<T>::type::STRING:
+                    case sqlite::column<T>::type::JSON: {
+                        const auto p = f.get_string_pointer();
+                        if ((*object).*p != object.get_original().*p) {
+                            dirty_fields.push_back(i);
+                        }
+                        break;
+                    }
+                }
+            }
+
+            return dirty_fields;
+        }
+
+        bool save(const std::string &table, sqlite::tracked<T> &object) {
+            const auto dirty_fields = get_dirty_fields(object);
+            if (dirty_fields.empty()) {
+                return true;
+            }
+
+            auto query = "UPDATE " + table + " SET ";
+            for (const auto i: dirty_fields) {
+                query += base::m_fields[i].get_name() + '=' + base::get_parameter(base::m_fields[i]) + ',';
+            }
+            query.back() = ' ';
+            query += "WHERE " + base::m_fields.front().get_name() + "=?";
+
+            const auto statement = statement_cache::get(base::m_db, query);
+            if (!statement) {
+                base::add_error(sqlite3_errmsg(base::m_db));
+                return false;
+            }
+
+            int index = 1;
+            for (const auto i: dirty_fields) {
+                const auto &f = base::m_fields[i];
+
+                switch (f.get_type()) {
+                    case sqlite::column<T>::type::INT:
+                        sqlite3_bind_int(statement, index++, (*object).*f.get_int_pointer());
+                        break;
+                    case sqlite::column<T>::type::STRING:
+                    case sqlite::column<T>::type::JSON:
+                        base::bind_text(statement, index++, f, (*object).*f.get_string_pointer());
+                        break;
+                }
+            }
+            sqlite3_bind_int(statement, index, (*object).*base::m_fields.front().get_int_pointer());
+
+            auto success = sqlite3_step(statement) == SQLITE_DONE;
+            if (!success) {
+                base::add_error(sqlite3_errmsg(base::m_db));
+            } else if (sqlite3_changes(base::m_db) == 0) {
+                base::add_error(("no row to save in " + table).c_str());
+                success = false;
+            }
+            sqlite3_reset(statement);
+            sqlite3_clear_bindings(statement);
+            hooks::dispatch(base::m_db);
+
+            // The object stays dirty when nothing was written, e.g. for a deleted row
+
+            if (success) {
+                object.mark_clean();
+            }
+
+            return success;
+        }
+
+        // Bulk upsert with one prepared statement, in a transaction of its own unless one is open.
+        // Objects with id 0 get a new rowid unless their unique key exists.
+
+        bool upsert(const std::string &table, const std::vector<std::shared_ptr<T>> &objects) {
+            std::string parameters;
+            for (const auto &f: base::m_fields) {
+                parameters += base::get_parameter(f);
+                parameters += ',';
+            }
+            parameters.pop_back();
+
+            const auto query = "INSERT INTO " + table + " (" + base::m_all_fields + ") VALUES (" + parameters + ") " +
+                               base::get_upsert_clause();
+
+            const auto statement = statement_cache::get(base::m_db, query);
+            if (!statement) {
+                base::add_error(sqlite3_errmsg(base::m_db));
+                return false;
+            }
+
+            const bool own_transaction = sqlite3_get_autocommit(base::m_db);
+            if (own_transaction) {
+                *this << BEGIN_TRANSACTION << ';';
+            }
+
+            bool success = true;
+            for (const auto &object: objects) {
+                for (size_t i = 0; i < base::m_fields.size(); ++i) {
+                    const auto &f = base::m_fields[i];
+                    const auto index = int(i + 1);
+
+                    switch (f.get_type()) {
+                        case sqlite::column<T>::type::INT: {
+                            const auto value = (*object).*f.get_int_pointer();
+                            if (i == 0 && value == 0) {
+                                sqlite3_bind_null(statement, index);
+                            } else {
+                                sqlite3_bind_int(statement, index, value);
+                            }
+                            break;
+                        }
+                        case sqlite::column<T>::type::STRING:
+                        case sqlite::column<T>::type::JSON:
+                            base::bind_text(statement, index, f, (*object).*f.get_string_pointer());
+                            break;
+                    }
+                }
+
+                success = sqlite3_step(statement) == SQLITE_DONE;
+                if (!success) {
+                    base::add_error(sqlite3_errmsg(base::m_db));
+                }
+                sqlite3_reset(statement);
+
+                if (!success) {
+                    break;
+                }
+            }
+            sqlite3_clear_bindings(statement);
+
+            // A failed commit, which records its own error, leaves the transaction open
+
+            if (own_transaction) {
+                if (success) {
+                    *this << COMMIT << ';';
+                    success = m_succeeded;
+                }
+                if (!success) {
+                    *this << ROLLBACK << ';';
+                }
+            } else {
+                hooks::dispatch(base::m_db);
+            }
+
+            return success;
+        }
+
+        // Projection of the built query, which starts from FROM, onto the given fields only, so
+        // that an index covering them can serve it
+
+        template<class... K>
+        std::vector<std::tuple<K...>> select(K T::* const ... pointers) {
+            project(pointers...);
+
+            std::vector<std::tuple<K...>> rows;
+            fetch(rows, [](auto &result, sqlite3_stmt *const statement) {
+                result.push_back(base::template read_fields<K...>(statement, std::index_sequence_for<K...>{}));
+            });
+            return rows;
+        }
+
+        // Same projection stored by column, one contiguous array per field
+
+        template<class... K>
+        std::tuple<columnar_t<K>...> select_columnar(K T::* const ... pointers) {
+            project(pointers...);
+
+            std::tuple<columnar_t<K>...> columns;
+            fetch(columns, [](auto &result, sqlite3_stmt *const statement) {
+                append_row<K...>(result, statement, std::index_sequence_for<K...>{});
+            });
+            return columns;
+        }
+
+        // Joins with the table of another mapped type on the same connection, read in one statement.
+        // The built query, if any, follows the join; its columns are prefixed by the aliases a and b.
+
+        template<class B, class K, class L>
+        std::vector<std::pair<T, B>> join(database<B> &other, const std::string &table, K T::* const key,
+                                          const std::string &other_table, L B::* const other_key) {
+            build_join(other, table, key, other_table, other_key, "JOIN");
+
+            std::vector<std::pair<T, B>> rows;
+            fetch(rows, [this, &other](auto &result, sqlite3_stmt *const statement) {
+                auto &row = result.emplace_back();
+                base::fill_object(statement, row.first);
+                other.fill_object(statement, row.second, int(base::m_fields.size()));
+            });
+            return rows;
+        }
+
+        // Objects with the joined objects referring to them, in the order of the first row of each
+
+        template<class B, class K, class L>
+        std::vector<std::pair<T, std::vector<B>>>
+        join_grouped(database<B> &other, const std::string &table, K T::* const key,
+                     const std::string &other_table, L B::* const other_key) {
+            build_join(other, table, key, other_table, other_key, "LEFT JOIN");
+
+            std::unordered_map<sqlite3_int64, size_t> positions;
+            std::vector<std::pair<T, std::vector<B>>> groups;
+            fetch(groups, [this, &other, &positions](auto &result, sqlite3_stmt *const statement) {
+                const auto id = sqlite3_column_int64(statement, 0);
+                auto position = positions.find(id);
+                if (position == positions.end()) {
+                    position = positions.emplace(id, result.size()).first;
+                    base::fill_object(statement, result.emplace_back().first);
+                }
+
+                // Objects without joined rows get NULL columns from the left join
+
+                const auto offset = int(base::m_fields.size());
+                if (sqlite3_column_type(statement, offset) != SQLITE_NULL) {
+                    other.fill_object(statement, result[position->second].second.emplace_back(), offset);
+                }
+            });
+            return groups;
+        }
+
+        // SQL functions. They're registered on the connection, so every database sharing it sees
+        // them; deterministic ones can be used in indexes and generated columns.
+
+        template<class F>
+        bool register_function(const std::string &name, F fn, bool deterministic = true) {
+            return functions::create_scalar(base::m_db, name, std::move(fn), deterministic) == SQLITE_OK;
+        }
+
+        template<class State, class Step, class Value>
+        bool register_aggregate(const std::string &name, Step step, Value value, bool deterministic = true) {
+            return functions::create_aggregate<State>(base::m_db, name, std::move(step), std::move(value),
+                                                      deterministic) == SQLITE_OK;
+        }
+
+        template<class State, class Step, class Inverse, class Value>
+        bool register_window(const std::string &name, Step step, Inverse inverse, Value value,
+                             bool deterministic = true) {
+            return functions::create_window<State>(base::m_db, name, std::move(step), std::move(inverse),
+                                                   std::move(value), deterministic) == SQLITE_OK;
+        }
+
+        // Read-only table over objects kept in memory, for joins without copying them into the
+        // database. Equality on the id or the unique key is looked up by hash; the container must
+        // outlive the statements using it and stay unchanged, exposing it again refreshes the table.
+
+        bool expose(const std::string &name, const std::vector<std::shared_ptr<T>> &objects) {
+            std::vector<size_t> keys{0};
+            keys.insert(keys.end(), base::m_unique_key.begin(), base::m_unique_key.end());
+
+            statement_cache::release(base::m_db, name);
+            return container_table<T>::create(base::m_db, name, base::m_fields, keys, objects) == SQLITE_OK;
+        }
+
+        // Full-text search. An FTS5 table indexes a copy of the given fields of the table, and
+        // triggers keep it in sync by rowid like the spatial index. An external content table
+        // can't be used: removing a row from it takes the old values, which a replacing insert
+        // doesn't report to triggers unless recursive triggers are enabled on the connection.
+
+        static std::string get_search_table(const std::string &table) {
+            return table + "_fts";
+        }
+
+        template<class... K>
+        bool enable_full_text_search(const std::string &table, K T::* const ... pointers) {
+            const auto search_table = get_search_table(table);
+            const auto &id = base::m_fields.front().get_name();
+
+            std::string columns, values, new_values;
+            const auto add = [this, &columns, &values, &new_values](const auto pointer) {
+                const auto &f = *base::find(pointer);
+                columns += ',' + f.get_name();
+                values += ',' + base::get_read_expression(f);
+                new_values += ',' + base::get_read_expression(f, "new.");
+            };
+            (add(pointers), ...);
+
+            const bool exists = has_table(search_table);
+
+            const auto insert = "INSERT INTO " + search_table + "(rowid" + columns + ") VALUES (new." + id +
+                                new_values + ");";
+            const auto remove = [&search_table](const std::string &rowid) {
+                return "DELETE FROM " + search_table + " WHERE rowid=" + rowid + ';';
+            };
+
+            base::m_query << "CREATE VIRTUAL TABLE IF NOT EXISTS " << search_table << " USING fts5("
+                          << columns.substr(1) << ");"
+                          << "CREATE TRIGGER IF NOT EXISTS " << search_table << "_insert AFTER INSERT ON " << table
+                          << " BEGIN " << remove("new." + id) << insert << " END;"
+                          << "CREATE TRIGGER IF NOT EXISTS " << search_table << "_delete AFTER DELETE ON " << table
+                          << " BEGIN " << remove("old." + id) << " END;"
+                          << "CREATE TRIGGER IF NOT EXISTS " << search_table << "_update AFTER UPDATE ON " << table
+                          << " BEGIN " << remove("old." + id) << remove("new." + id) << insert << " END;";
+            if (!exists) {
+                base::m_query << "INSERT INTO " << search_table << "(rowid" << columns << ") SELECT " << id
+                              << values << " FROM " << table << ';';
+            }
+
+            return exec_script();
+        }
+
+        // Rows matching an FTS5 query, best ranked first
+
+        std::vector<std::shared_ptr<T>> search(const std::string &table, const std::string &query, int limit = -1) {
+            const auto search_table = get_search_table(table);
+
+            base::m_query << "SELECT " << get_qualified_fields(table) << " FROM " << search_table << " JOIN " << table
+                          << " ON " << table << '.' << base::m_fields.front().get_name() << '=' << search_table << ".rowid"
+                          << " WHERE " << search_table << " MATCH ? ORDER BY " << search_table << ".rank"
+                          << " LIMIT " << limit;
+            base::m_parameters.push_back(query);
+
+            std::vector<std::shared_ptr<T>> objects;
+            *this >> objects;
+            return objects;
+        }
+
+        // Spatial index. An R*Tree over integer bounds of the rows answers bounding box queries
+        // without scanning, and triggers keep it in sync with the table.
+
+        static std::string get_spatial_table(const std::string &table) {
+            return table + "_rtree";
+        }
+
+        bool enable_spatial_index(const std::string &table, int T::* const min_x, int T::* const max_x,
+                                  int T::* const min_y, int T::* const max_y) {
+            const auto spatial_table = get_spatial_table(table);
+            const auto &id = base::m_fields.front().get_name();
+
+            std::vector<std::string> columns{id};
+            for (const auto pointer: {min_x, max_x, min_y, max_y}) {
+                columns.push_back(base::find(pointer)->get_name());
+            }
+
+            const auto values = [&columns](const std::string &prefix) {
+                std::string result;
+                for (const auto &column: columns) {
+                    result += prefix + column + ',';
+                }
+                result.pop_back();
+                return result;
+            };
+
+            const bool exists = has_table(spatial_table);
+
+            const auto insert = "INSERT OR REPLACE INTO " + spatial_table + " VALUES (" + values("new.") + ");";
+            const auto remove = "DELETE FROM " + spatial_table + " WHERE id=old." + id + ';';
+
+            base::m_query << "CREATE VIRTUAL TABLE IF NOT EXISTS " << spatial_table
+                          << " USING rtree_i32(id,min_x,max_x,min_y,max_y);"
+                          << "CREATE TRIGGER IF NOT EXISTS " << spatial_table << "_insert AFTER INSERT ON " << table
+                          << " BEGIN " << insert << " END;"
+                          << "CREATE TRIGGER IF NOT EXISTS " << spatial_table << "_delete AFTER DELETE ON " << table
+                          << " BEGIN " << remove << " END;"
+                          << "CREATE TRIGGER IF NOT EXISTS " << spatial_table << "_update AFTER UPDATE ON " << table
+                          << " BEGIN " << remove << insert << " END;";
+            if (!exists) {
+                base::m_query << "INSERT INTO " << spatial_table << " SELECT " << values("") << " FROM " << table
+                              << ';';
+            }
+
+            return exec_script();
+        }
+
+        bool enable_spatial_index(const std::string &table, int T::* const x, int T::* const y) {
+            return enable_spatial_index(table, x, x, y, y);
+        }
+
+        // Rows whose bounds intersect the box, found through the R*Tree
+
+        std::vector<std::shared_ptr<T>> find_in_box(const std::string &table, int min_x, int max_x,
+                                                    int min_y, int max_y) {
+            const auto spatial_table = get_spatial_table(table);
+
+            base::m_query << "SELECT " << get_qualified_fields(table) << " FROM " << spatial_table << " JOIN " << table
+                          << " ON " << table << '.' << base::m_fields.front().get_name() << '=' << spatial_table << ".id"
+                          << " WHERE " << spatial_table << ".max_x>=" << min_x << " AND " << spatial_table
+                          << ".min_x<=" << max_x << " AND " << spatial_table << ".max_y>=" << min_y << " AND "
+                          << spatial_table << ".min_y<=" << max_y;
+
+            std::vector<std::shared_ptr<T>> objects;
+            *this >> objects;
+            return objects;
         }
 
+    private:
+
+        static constexpr auto fingerprints_table = "_orm_fingerprints";
+
+        std::string get_qualified_fields(const std::string &table) const {
+            std::string fields;
+            for (const auto &f: base::m_fields) {
+                fields += base::get_read_expression(f, table + '.') + ',';
+            }
+            fields.pop_back();
+            return fields;
+        }
+
+        bool has_table(const std::string &table) {
+            *this << SELECT << COUNT << FROM << "sqlite_master" << WHERE << "name" << EQUALS << table;
+            return int(*this) > 0;
+        }
+
+        bool has_unique_index(const std::string &table) {
+            *this << SELECT << COUNT << FROM << "pragma_index_list(" << table << ")"
+                  << WHERE << "\"unique\"" << EQUALS << 1 << AND << "origin" << NOT_EQUALS << "'pk'";
+            return int(*this) > 0;
+        }
+
+        // Runs the statements of the built query at once, in a transaction of its own unless one is open
+
+        bool exec_script() {
+            const bool own_transaction = sqlite3_get_autocommit(base::m_db);
+            if (own_transaction) {
+                const auto script = base::get_query();
+                base::m_query.str({});
+                base::m_query << "BEGIN TRANSACTION;" << script << "COMMIT;";
+            }
+
+            m_succeeded = base::exec();
+            if (!m_succeeded && own_transaction && !sqlite3_get_autocommit(base::m_db)) {
+                sqlite3_exec(base::m_db, "ROLLBACK", nullptr, nullptr, nullptr);
+            }
+            return m_succeeded;
+        }
+
+        template<class C, class = void>
+        struct is_container : std::false_type {
+        };
+
+        template<class C>
+        struct is_container<C, std::void_t<typename C::value_type, decltype(std::declval<C>().begin())>>
+                : std::true_type {
+        };
+
     private:
 
         command m_active_command = command::NONE;
 
+        bool m_succeeded = true;
+
+        std::unordered_map<std::string, std::pair<std::shared_ptr<identity_map<T>>, size_t>> m_identity_maps;
+
+        std::shared_ptr<query_cache> m_query_cache;
+        size_t m_query_cache_listener = 0;
+
+        std::unordered_set<size_t> m_subscriptions;
+
+        std::unique_ptr<read_pool> m_read_pool;
+
     private:
 
         static std::shared_ptr<sqlite::database<T>>
@@ -520,6 +1543,157 @@ namespace sqlite {
             return std::make_shared<sqlite::database<T>>(db);
         }
 
+        template<class... K>
+        void project(K T::* const ... pointers) {
+            std::string columns;
+            const auto add = [this, &columns](const auto pointer) {
+                const auto it = base::find(pointer);
+                columns += it == base::m_fields.end() ? "NULL" : base::get_read_expression(*it);
+                columns += ',';
+            };
+            (add(pointers), ...);
+            columns.pop_back();
+
+            const auto tail = base::get_query();
+            base::m_query.str({});
+            base::m_query << "SELECT " << columns << ' ' << tail;
+        }
+
+        template<class B, class K, class L>
+        void build_join(database<B> &other, const std::string &table, K T::* const key,
+                        const std::string &other_table, L B::* const other_key, const char *join) {
+            const auto tail = base::get_query();
+            base::m_query.str({});
+            base::m_query << "SELECT " << get_qualified_fields("a") << ',' << other.get_qualified_fields("b")
+                          << " FROM " << table << " a " << join << ' ' << other_table << " b ON a."
+                          << base::find(key)->get_name() << "=b." << other.find(other_key)->get_name() << ' '
+                          << tail;
+        }
+
+        template<class... K, class C, size_t... I>
+        static void append_row(C &columns, sqlite3_stmt *statement, std::index_sequence<I...>) {
+            (append_value<K>(std::get<I>(columns), statement, int(I)), ...);
+        }
+
+        template<class V>
+        static void append_value(columnar_t<V> &column, sqlite3_stmt *statement, int i) {
+            if constexpr (std::is_same_v<V, std::string>) {
+                const auto text = reinterpret_cast<const char *>(sqlite3_column_text(statement, i));
+                column.push_back(text ? text : "", size_t(sqlite3_column_bytes(statement, i)));
+            } else {
+                column.push_back(base::template read_field<V>(statement, i));
+            }
+        }
+
+        template<class C, class F>
+        void fetch(C &container, const F &fn) {
+            if (!m_query_cache) {
+                base::iterate([&](sqlite3_stmt *const statement) {
+                    fn(container, statement);
+                });
+                return;
+            }
+
+            const auto key = get_cache_key<C>();
+            if (const auto cached = m_query_cache->template get<C>(key)) {
+                base::clear();
+                merge(container, *cached);
+                return;
+            }
+
+            const auto version = m_query_cache->get_version();
+            const auto result = std::make_shared<C>();
+
+            // Tables are reported when a statement is prepared, or by statement_cache when it's reused
+
+            std::unordered_set<std::string> tables;
+            hooks::capture_reads(&tables);
+            bool success;
+            try {
+                success = base::iterate([&](sqlite3_stmt *const statement) {
+                    fn(*result, statement);
+                });
+            } catch (...) {
+                hooks::capture_reads(nullptr);
+                throw;
+            }
+            hooks::capture_reads(nullptr);
+
+            if (success) {
+                if (!tables.empty()) {
+                    m_query_cache->template put<C>(key, result, tables, version);
+                }
+                merge(container, *result);
+            }
+        }
+
+        template<class C>
+        std::string get_cache_key() const {
+            auto key = base::get_query();
+            key += '\n';
+            key += typeid(C).name();
+            key += '\n';
+            key += std::to_string(base::find_column(base::m_int_pointer));
+            key += ',';
+            key += std::to_string(base::find_column(base::m_string_pointer));
+            for (const auto &parameter: base::m_parameters) {
+                key += '\n';
+                key += parameter;
+            }
+            return key;
+        }
+
+        template<class C>
+        static void merge(C &target, const C &source) {
+            if constexpr (is_container<C>::value) {
+                for (const auto &value: source) {
+                    target.insert(target.end(), value);
+                }
+            } else {
+                target = source;
+            }
+        }
+
+        // Reads rows with a statement of its own, as it may run while a query is being built
+
+        void load_objects(const std::string &table, const std::vector<sqlite3_int64> &rowids,
+                          std::unordered_map<sqlite3_int64, std::shared_ptr<T>> &objects) {
+            if (rowids.empty()) {
+                return;
+            }
+
+            auto query = "SELECT " + base::m_selected_fields + " FROM " + table + " WHERE rowid IN (";
+            for (const auto rowid: rowids) {
+                query += std::to_string(rowid);
+                query += ',';
+            }
+            query.back() = ')';
+
+            sqlite3_stmt *statement;
+            if (sqlite3_prepare_v2(base::m_db, query.c_str(), -1, &statement, nullptr) != SQLITE_OK) {
+                return;
+            }
+
+            while (sqlite3_step(statement) == SQLITE_ROW) {
+                objects.emplace(sqlite3_column_int64(statement, 0), base::make_object(statement));
+            }
+
+            sqlite3_finalize(statement);
+        }
+
+        uint32_t get_fingerprint(const std::string &table) {
+            *this << SELECT << "fingerprint" << FROM << fingerprints_table << WHERE << "name" << EQUALS << table;
+            const int32_t fingerprint = *this;
+            return uint32_t(fingerprint);
+        }
+
+        void set_fingerprint(const std::string &table) {
+            *this << CREATE_TABLE_IF_NOT_EXISTS << fingerprints_table
+                  << '(' << "name text primary key, fingerprint integer" << ')' << ';';
+            *this << INSERT_OR_REPLACE_INTO << fingerprints_table
+                  << VALUES << '(' << table << ',' << int32_t(base::m_fingerprint) << ')' << ';';
+        }
+
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,239 @@
+//
+//  functions.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "sqlite3.h"
+
+namespace sqlite {
+
+    // SQL functions backed by C++ callables, either function pointers or objects with a single
+    // operator(), with argument and result types deduced from the signature. Aggregates and
+    // window functions keep a State object per group or frame, built on the first step:
+    // step(State &, args...) and value(const State &) -> result, plus inverse(State &, args...)
+    // for windows.
+
+    class functions {
+    public:
+
+        template<class F>
+        static int create_scalar(sqlite3 *db, const std::string &name, F fn, bool deterministic) {
+            using traits = callable<F>;
+
+            return sqlite3_create_function_v2(
+                    db, name.c_str(), int(std::tuple_size_v<typename traits::arguments>), flags(deterministic),
+                    new F(std::move(fn)), &call_scalar<F>, nullptr, nullptr, &destroy<F>);
+        }
+
+        template<class State, class Step, class Value>
+        static int create_aggregate(sqlite3 *db, const std::string &name, Step step, Value value, bool deterministic) {
+            using aggregate = functions::aggregate<State, Step, Value, std::nullptr_t>;
+            using arguments = typename callable<Step>::arguments;
+
+            return sqlite3_create_function_v2(
+                    db, name.c_str(), int(std::tuple_size_v<arguments>) - 1, flags(deterministic),
+                    new aggregate{std::move(step), std::move(value), nullptr}, nullptr, &aggregate::step,
+                    &aggregate::final, &destroy<aggregate>);
+        }
+
+        template<class State, class Step, class Inverse, class Value>
+        static int create_window(sqlite3 *db, const std::string &name, Step step, Inverse inverse, Value value,
+                                 bool deterministic) {
+            using aggregate = functions::aggregate<State, Step, Value, Inverse>;
+            using arguments = typename callable<Step>::arguments;
+
+            return sqlite3_create_window_function(
+                    db, name.c_str(), int(std::tuple_size_v<arguments>) - 1, flags(deterministic),
+                    new aggregate{std::move(step), std::move(value), std::move(inverse)}, &aggregate::step,
+                    &aggregate::final, &aggregate::value, &aggregate::inverse, &destroy<aggregate>);
+        }
+
+    private:
+
+        template<class M>
+        struct signature;
+
+        template<class C, class R, class... A>
+        struct signature<R (C::*)(A...) const> {
+            using result = R;
+            using arguments = std::tuple<std::decay_t<A>...>;
+        };
+
+        template<class C, class R, class... A>
+        struct signature<R (C::*)(A...)> : signature<R (C::*)(A...) const> {
+        };
+
+        template<class F>
+        struct callable : signature<decltype(&F::operator())> {
+        };
+
+        template<class R, class... A>
+        struct callable<R (*)(A...)> {
+            using result = R;
+            using arguments = std::tuple<std::decay_t<A>...>;
+        };
+
+        template<class State, class Step, class Value, class Inverse>
+        struct aggregate {
+
+            Step step_fn;
+            Value value_fn;
+            Inverse inverse_fn;
+
+            static State *get_state(sqlite3_context *context, bool create) {
+                const auto size = create ? int(sizeof(State *)) : 0;
+                const auto slot = static_cast<State **>(sqlite3_aggregate_context(context, size));
+                if (!slot) {
+                    return nullptr;
+                }
+
+                if (!*slot && create) {
+                    *slot = new State();
+                }
+
+                return *slot;
+            }
+
+            template<class F>
+            static void apply(sqlite3_context *context, F &fn, int, sqlite3_value **argv) {
+                using arguments = typename callable<F>::arguments;
+                using values = decltype(tail(std::declval<arguments>()));
+
+                const auto state = get_state(context, true);
+                if (!state) {
+                    sqlite3_result_error_nomem(context);
+                    return;
+                }
+
+                guard(context, [&] {
+                    call(fn, values(), argv, std::make_index_sequence<std::tuple_size_v<values>>(), *state);
+                });
+            }
+
+            static void step(sqlite3_context *context, int argc, sqlite3_value **argv) {
+                auto &self = *static_cast<aggregate *>(sqlite3_user_data(context));
+                apply(context, self.step_fn, argc, argv);
+            }
+
+            static void inverse(sqlite3_context *context, int argc, sqlite3_value **argv) {
+                auto &self = *static_cast<aggregate *>(sqlite3_user_data(context));
+                apply(context, self.inverse_fn, argc, argv);
+            }
+
+            static void value(sqlite3_context *context) {
+                auto &self = *static_cast<aggregate *>(sqlite3_user_data(context));
+                const auto state = get_state(context, true);
+                guard(context, [&] {
+                    set_result(context, self.value_fn(*state));
+                });
+            }
+
+            static void final(sqlite3_context *context) {
+                auto &self = *static_cast<aggregate *>(sqlite3_user_data(context));
+
+                // Without rows there's no state yet, the result is that of an empty one
+
+                auto state = get_state(context, false);
+                const auto empty = !state;
+                if (empty) {
+                    state = new State();
+                }
+
+                guard(context, [&] {
+                    set_result(context, self.value_fn(*state));
+                });
+
+                delete state;
+            }
+
+        };
+
+    private:
+
+        static int flags(bool deterministic) {
+            return SQLITE_UTF8 | (deterministic ? SQLITE_DETERMINISTIC : 0);
+        }
+
+        template<class F>
+        static void destroy(void *data) {
+            delete static_cast<F *>(data);
+        }
+
+        template<class F>
+        static void guard(sqlite3_context *context, const F &fn) {
+            try {
+                fn();
+            } catch (const std::exception &e) {
+                sqlite3_result_error(context, e.what(), -1);
+            } catch (...) {
+                sqlite3_result_error(context, "unknown error", -1);
+            }
+        }
+
+        template<class F>
+        static void call_scalar(sqlite3_context *context, int, sqlite3_value **argv) {
+            using traits = callable<F>;
+            using arguments = typename traits::arguments;
+
+            auto &fn = *static_cast<F *>(sqlite3_user_data(context));
+            guard(context, [&] {
+                if constexpr (std::is_void_v<typename traits::result>) {
+                    call(fn, arguments(), argv, std::make_index_sequence<std::tuple_size_v<arguments>>());
+                    sqlite3_result_null(context);
+                } else {
+                    set_result(context, call(fn, arguments(), argv,
+                                             std::make_index_sequence<std::tuple_size_v<arguments>>()));
+                }
+            });
+        }
+
+        template<class F, class... A, size_t... I, class... S>
+        static decltype(auto) call(F &fn, std::tuple<A...>, sqlite3_value **argv, std::index_sequence<I...>,
+                                   S &... state) {
+            return fn(state..., get_value<A>(argv[I])...);
+        }
+
+        template<class H, class... A>
+        static std::tuple<A...> tail(std::tuple<H, A...>);
+
+        template<class V>
+        static V get_value(sqlite3_value *value) {
+            if constexpr (std::is_same_v<V, bool>) {
+                return sqlite3_value_int(value) != 0;
+            } else if constexpr (std::is_floating_point_v<V>) {
+                return V(sqlite3_value_double(value));
+            } else if constexpr (std::is_integral_v<V>) {
+                return V(sqlite3_value_int64(value));
+            } else {
+                const auto text = reinterpret_cast<const char *>(sqlite3_value_text(value));
+                return text ? V(text, size_t(sqlite3_value_bytes(value))) : V();
+            }
+        }
+
+        template<class V>
+        static void set_result(sqlite3_context *context, const V &value) {
+            if constexpr (std::is_floating_point_v<V>) {
+                sqlite3_result_double(context, double(value));
+            } else if constexpr (std::is_integral_v<V>) {
+                sqlite3_result_int64(context, sqlite3_int64(value));
+            } else {
+                sqlite3_result_text(context, value.data(), int(value.size()), SQLITE_TRANSIENT);
+            }
+        }
+
+    };
+
+}
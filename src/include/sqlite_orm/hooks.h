@@ -0,0 +1,208 @@
+//
+//  hooks.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "sqlite3.h"
+
+namespace sqlite {
+
+    // SQLite keeps a single update, commit and rollback hook per connection, while connections
+    // are shared through db_cache, so listeners are multiplexed here. Listeners called from
+    // the hooks must neither use the connection nor add or remove listeners; idle listeners run
+    // from dispatch() once a statement has finished and may do both.
+
+    class hooks {
+    public:
+
+        using update_listener = std::function<void(int operation, const char *table, sqlite3_int64 rowid)>;
+        using transaction_listener = std::function<void(bool committed)>;
+        using idle_listener = std::function<void()>;
+
+        struct listener {
+            update_listener on_update;
+            transaction_listener on_transaction;
+            idle_listener on_idle;
+        };
+
+    public:
+
+        static size_t add_listener(sqlite3 *db, const listener &listener) {
+            std::lock_guard<std::mutex> lock(s_mutex);
+
+            auto &state = s_states[db];
+            if (!state) {
+                state = std::make_unique<hooks::state>();
+                install(db, state.get());
+            }
+
+            const auto id = s_next_id++;
+
+            std::lock_guard<std::mutex> state_lock(state->mutex);
+            state->listeners.emplace(id, listener);
+
+            return id;
+        }
+
+        static size_t add_update_listener(sqlite3 *db, const update_listener &listener) {
+            return add_listener(db, {listener, {}, {}});
+        }
+
+        static void remove_listener(sqlite3 *db, size_t id) {
+            std::lock_guard<std::mutex> lock(s_mutex);
+
+            const auto it = s_states.find(db);
+            if (it == s_states.end()) {
+                return;
+            }
+
+            auto &state = *it->second;
+
+            std::unique_lock<std::mutex> state_lock(state.mutex);
+            state.listeners.erase(id);
+
+            if (state.listeners.empty()) {
+                state_lock.unlock();
+
+                install(db, nullptr);
+                s_states.erase(it);
+            }
+        }
+
+        // Runs idle listeners, called after each statement executed on the connection
+
+        static void dispatch(sqlite3 *db) {
+            std::vector<idle_listener> listeners;
+
+            {
+                std::lock_guard<std::mutex> lock(s_mutex);
+
+                const auto it = s_states.find(db);
+                if (it == s_states.end()) {
+                    return;
+                }
+
+                auto &state = *it->second;
+
+                std::lock_guard<std::mutex> state_lock(state.mutex);
+                for (const auto &[id, listener]: state.listeners) {
+                    if (listener.on_idle) {
+                        listeners.push_back(listener.on_idle);
+                    }
+                }
+            }
+
+            for (const auto &listener: listeners) {
+                listener();
+            }
+        }
+
+        // Collects the tables read by statements prepared on this thread while set
+
+        static void capture_reads(std::unordered_set<std::string> *tables) {
+            s_reads = tables;
+        }
+
+        static std::unordered_set<std::string> *get_reads() {
+            return s_reads;
+        }
+
+        static void release(sqlite3 *db) {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            s_states.erase(db);
+        }
+
+    private:
+
+        struct state {
+            std::mutex mutex;
+            std::unordered_map<size_t, listener> listeners;
+        };
+
+    private:
+
+        static inline std::mutex s_mutex;
+        static inline std::unordered_map<sqlite3 *, std::unique_ptr<state>> s_states;
+        static inline size_t s_next_id = 1;
+
+        static inline thread_local std::unordered_set<std::string> *s_reads = nullptr;
+
+    private:
+
+        static void install(sqlite3 *db, state *state) {
+            if (state) {
+                sqlite3_update_hook(db, on_update, state);
+                sqlite3_commit_hook(db, on_commit, state);
+                sqlite3_rollback_hook(db, on_rollback, state);
+                sqlite3_set_authorizer(db, on_authorize, state);
+            } else {
+                sqlite3_update_hook(db, nullptr, nullptr);
+                sqlite3_commit_hook(db, nullptr, nullptr);
+                sqlite3_rollback_hook(db, nullptr, nullptr);
+                sqlite3_set_authorizer(db, nullptr, nullptr);
+            }
+        }
+
+        static void on_update(void *data, int operation, const char *, const char *table, sqlite3_int64 rowid) {
+            auto &state = *static_cast<hooks::state *>(data);
+
+            std::lock_guard<std::mutex> lock(state.mutex);
+            for (const auto &[id, listener]: state.listeners) {
+                if (listener.on_update) {
+                    listener.on_update(operation, table, rowid);
+                }
+            }
+        }
+
+        static void on_transaction(void *data, bool committed) {
+            auto &state = *static_cast<hooks::state *>(data);
+
+            std::lock_guard<std::mutex> lock(state.mutex);
+            for (const auto &[id, listener]: state.listeners) {
+                if (listener.on_transaction) {
+                    listener.on_transaction(committed);
+                }
+            }
+        }
+
+        static int on_commit(void *data) {
+            on_transaction(data, true);
+            return 0;
+        }
+
+        static void on_rollback(void *data) {
+            on_transaction(data, false);
+        }
+
+        static int on_authorize(void *, int action, const char *table, const char *, const char *, const char *) {
+
+            // The truncate optimization of DELETE without WHERE skips the update hook
+
+            if (action == SQLITE_DELETE && table && strncmp(table, "sqlite_", 7) != 0) {
+                return SQLITE_IGNORE;
+            }
+
+            if (action == SQLITE_READ && table && s_reads) {
+                s_reads->emplace(table);
+            }
+
+            return SQLITE_OK;
+        }
+
+    };
+
+}
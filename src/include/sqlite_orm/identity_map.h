@@ -0,0 +1,132 @@
+//
+//  identity_map.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "sqlite3.h"
+
+namespace sqlite {
+
+    // Objects by rowid, least recently used ones are dropped above capacity. In weak mode
+    // the map only remembers objects that are still referenced elsewhere.
+
+    template<class T>
+    class identity_map {
+    public:
+
+        identity_map(size_t capacity, bool weak) : m_capacity(capacity), m_weak(weak) {}
+
+    public:
+
+        std::shared_ptr<T> find(sqlite3_int64 rowid) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            const auto it = m_entries.find(rowid);
+            if (it == m_entries.end()) {
+                return nullptr;
+            }
+
+            auto &entry = it->second;
+            auto object = m_weak ? entry.weak.lock() : entry.strong;
+            if (!object) {
+                m_lru.erase(entry.position);
+                m_entries.erase(it);
+                return nullptr;
+            }
+
+            m_lru.splice(m_lru.begin(), m_lru, entry.position);
+            return object;
+        }
+
+        void put(sqlite3_int64 rowid, const std::shared_ptr<T> &object, size_t version) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (version != m_version || m_capacity == 0) {
+                return;
+            }
+
+            erase_entry(rowid);
+
+            m_lru.push_front(rowid);
+            auto &entry = m_entries[rowid];
+            entry.position = m_lru.begin();
+            if (m_weak) {
+                entry.weak = object;
+            } else {
+                entry.strong = object;
+            }
+
+            while (m_entries.size() > m_capacity) {
+                m_entries.erase(m_lru.back());
+                m_lru.pop_back();
+            }
+        }
+
+        void erase(sqlite3_int64 rowid) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            ++m_version;
+            erase_entry(rowid);
+        }
+
+        void clear() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            ++m_version;
+            m_entries.clear();
+            m_lru.clear();
+        }
+
+        size_t get_version() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_version;
+        }
+
+        size_t size() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_entries.size();
+        }
+
+    private:
+
+        struct entry {
+            std::shared_ptr<T> strong;
+            std::weak_ptr<T> weak;
+            std::list<sqlite3_int64>::iterator position;
+        };
+
+    private:
+
+        const size_t m_capacity;
+        const bool m_weak;
+
+        mutable std::mutex m_mutex;
+
+        std::unordered_map<sqlite3_int64, entry> m_entries;
+        std::list<sqlite3_int64> m_lru;
+
+        size_t m_version = 0;
+
+    private:
+
+        void erase_entry(sqlite3_int64 rowid) {
+            const auto it = m_entries.find(rowid);
+            if (it != m_entries.end()) {
+                m_lru.erase(it->second.position);
+                m_entries.erase(it);
+            }
+        }
+
+    };
+
+}
@@ -0,0 +1,31 @@
+//
+//  json_path.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <string>
+
+namespace sqlite {
+
+    // Value at a path of a JSON field in queries. It's written as the generated column declared
+    // for the path when there is one, so that an index on that column can serve the query.
+
+    template<class T>
+    struct json_path {
+
+        std::string T::* const field;
+        const std::string path;
+
+    };
+
+    template<class T>
+    json_path<T> json_extract(std::string T::* const field, const std::string &path) {
+        return {field, path};
+    }
+
+}
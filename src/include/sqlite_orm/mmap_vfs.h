@@ -0,0 +1,20 @@
+//
+//  mmap_vfs.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+namespace sqlite {
+
+    extern const char *mmap_vfs_name;
+
+    // Read-only VFS for immutable database files. Pages are served straight from the mapping
+    // once memory-mapped I/O is enabled with PRAGMA mmap_size.
+
+    int register_mmap_vfs(const char *name = mmap_vfs_name);
+
+}
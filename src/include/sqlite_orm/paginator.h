@@ -0,0 +1,144 @@
+//
+//  paginator.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column.h"
+#include "statement_cache.h"
+#include "sqlite3.h"
+
+namespace sqlite {
+
+    // Keyset pagination over the rows of a query. Each page starts after the sort keys of the
+    // last row of the previous one, so its cost doesn't depend on how many rows were skipped.
+    // Both statements are kept by statement_cache, so they are finalized with the connection's
+    // other statements, and rebound for every page with the raw key values of the last row.
+
+    template<class T>
+    class paginator {
+    public:
+
+        using decoder = std::function<std::shared_ptr<T>(sqlite3_stmt *)>;
+        using visitor = std::function<void(const std::shared_ptr<T> &)>;
+
+    public:
+
+        // Keys are given with their positions among the columns of the query
+
+        paginator(sqlite3 *const db, const std::string &query, const std::vector<column<T>> &keys,
+                  const std::vector<int> &positions, int page_size, const decoder &decoder)
+                : m_db(db), m_positions(positions), m_page_size(size_t(page_size)), m_decoder(decoder) {
+            std::string order_by;
+            std::string parameters;
+            for (const auto &key: keys) {
+                order_by += key.get_name() + ',';
+                parameters += "?,";
+            }
+            order_by.pop_back();
+            parameters.pop_back();
+
+            const auto select = "SELECT * FROM (" + query + ") ";
+            const auto limit = " ORDER BY " + order_by + " LIMIT " + std::to_string(page_size);
+
+            m_first = select + limit;
+            m_next = select + "WHERE (" + order_by + ") > (" + parameters + ")" + limit;
+        }
+
+        ~paginator() {
+            clear_last();
+        }
+
+        paginator(const paginator &) = delete;
+
+        paginator &operator=(const paginator &) = delete;
+
+    public:
+
+        // Calls the visitor for each row of the next page and returns their count, 0 at the end
+
+        size_t next(const visitor &visitor) {
+            if (m_done) {
+                return 0;
+            }
+
+            const auto statement = statement_cache::get(m_db, m_last.empty() ? m_first : m_next);
+            if (!statement) {
+                return 0;
+            }
+            for (size_t i = 0; i < m_last.size(); ++i) {
+                sqlite3_bind_value(statement, int(i + 1), m_last[i]);
+            }
+
+            size_t count = 0;
+            while (sqlite3_step(statement) == SQLITE_ROW) {
+                clear_last();
+                for (const auto position: m_positions) {
+                    m_last.push_back(sqlite3_value_dup(sqlite3_column_value(statement, position)));
+                }
+
+                visitor(m_decoder(statement));
+                ++count;
+            }
+
+            sqlite3_reset(statement);
+            sqlite3_clear_bindings(statement);
+
+            // A short page is the last one
+
+            m_done = count < m_page_size;
+
+            return count;
+        }
+
+        std::vector<std::shared_ptr<T>> next() {
+            std::vector<std::shared_ptr<T>> page;
+            next([&page](const std::shared_ptr<T> &object) {
+                page.push_back(object);
+            });
+            return page;
+        }
+
+        bool is_done() const {
+            return m_done;
+        }
+
+        void rewind() {
+            clear_last();
+            m_done = false;
+        }
+
+    private:
+
+        sqlite3 *const m_db;
+        const std::vector<int> m_positions;
+        const size_t m_page_size;
+        const decoder m_decoder;
+
+        std::string m_first;
+        std::string m_next;
+
+        std::vector<sqlite3_value *> m_last;
+        bool m_done = false;
+
+    private:
+
+        void clear_last() {
+            for (const auto value: m_last) {
+                sqlite3_value_free(value);
+            }
+            m_last.clear();
+        }
+
+    };
+
+}
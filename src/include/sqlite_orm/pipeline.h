@@ -0,0 +1,200 @@
+//
+//  pipeline.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bounded_queue.h"
+
+namespace sqlite {
+
+    // Hands rows decoded on the stepping thread to consumer threads. Rows are decoded in place
+    // into batches of reused objects; a batch goes to a worker's queue when full, idle workers
+    // steal from the queues of others, and the stepping thread waits for a batch to be released
+    // when all of them are in flight. Queues are lock-free; the mutex only serves the waits of
+    // idle workers and of the blocked stepping thread.
+
+    template<class T>
+    class pipeline {
+    public:
+
+        using consumer = std::function<void(const T &)>;
+
+    public:
+
+        pipeline(size_t workers, size_t batch_size, size_t depth, const consumer &consumer) :
+                m_batch_size(std::max<size_t>(batch_size, 1)), m_consumer(consumer),
+                m_free(std::max<size_t>(workers, 1) * std::max<size_t>(depth, 1)) {
+            workers = std::max<size_t>(workers, 1);
+
+            const auto batches = workers * std::max<size_t>(depth, 1);
+            m_batches.resize(batches);
+            for (auto &batch: m_batches) {
+                batch.objects.resize(m_batch_size);
+                m_free.push(&batch);
+            }
+
+            for (size_t i = 0; i < workers; ++i) {
+                m_queues.push_back(std::make_unique<bounded_queue<pipeline::batch *>>(batches));
+            }
+
+            for (size_t i = 0; i < workers; ++i) {
+                m_threads.emplace_back(&pipeline::run, this, i);
+            }
+        }
+
+        ~pipeline() {
+            finish();
+        }
+
+        pipeline(const pipeline &) = delete;
+
+        pipeline &operator=(const pipeline &) = delete;
+
+    public:
+
+        // Object to decode the next row into
+
+        T &next() {
+            if (m_batch && m_batch->size == m_batch_size) {
+                dispatch();
+            }
+
+            if (!m_batch && !m_free.pop(m_batch)) {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_released.wait(lock, [this] {
+                    m_wakeups.fetch_add(1, std::memory_order_relaxed);
+                    return m_free.pop(m_batch);
+                });
+            }
+
+            return m_batch->objects[m_batch->size++];
+        }
+
+        // Hands over the last batch and waits for the consumers
+
+        void finish() {
+            if (m_batch) {
+                dispatch();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_done.store(true, std::memory_order_release);
+            }
+            m_ready.notify_all();
+
+            for (auto &thread: m_threads) {
+                if (thread.joinable()) {
+                    thread.join();
+                }
+            }
+        }
+
+        // Checks made by waiting threads, once when they start waiting and once per wakeup. It
+        // stays in the order of the number of batches as long as waiting threads are blocked.
+
+        size_t get_wakeups() const {
+            return m_wakeups.load(std::memory_order_relaxed);
+        }
+
+    private:
+
+        struct batch {
+            std::vector<T> objects;
+            size_t size = 0;
+        };
+
+    private:
+
+        const size_t m_batch_size;
+        const consumer m_consumer;
+
+        std::vector<batch> m_batches;
+        bounded_queue<batch *> m_free;
+        std::vector<std::unique_ptr<bounded_queue<batch *>>> m_queues;
+        std::vector<std::thread> m_threads;
+
+        batch *m_batch = nullptr;
+        size_t m_next_queue = 0;
+
+        std::atomic<bool> m_done{false};
+        std::atomic<size_t> m_wakeups{0};
+
+        std::mutex m_mutex;
+        std::condition_variable m_ready;
+        std::condition_variable m_released;
+
+    private:
+
+        void dispatch() {
+
+            // Queues hold every batch, so pushing never fails
+
+            m_queues[m_next_queue]->push(m_batch);
+            m_next_queue = (m_next_queue + 1) % m_queues.size();
+            m_batch = nullptr;
+
+            notify(m_ready);
+        }
+
+        // Taking the mutex orders the notification after the check of a thread about to wait
+
+        void notify(std::condition_variable &condition) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+            }
+            condition.notify_one();
+        }
+
+        bool take(size_t worker, batch *&batch) {
+            for (size_t i = 0; i < m_queues.size(); ++i) {
+                if (m_queues[(worker + i) % m_queues.size()]->pop(batch)) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void run(size_t worker) {
+            for (;;) {
+                batch *batch = nullptr;
+                if (!take(worker, batch)) {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_ready.wait(lock, [this, worker, &batch] {
+                        m_wakeups.fetch_add(1, std::memory_order_relaxed);
+                        return take(worker, batch) || m_done.load(std::memory_order_acquire);
+                    });
+
+                    if (!batch) {
+                        return;
+                    }
+                }
+
+                for (size_t i = 0; i < batch->size; ++i) {
+                    m_consumer(batch->objects[i]);
+                }
+
+                batch->size = 0;
+                m_free.push(batch);
+                notify(m_released);
+            }
+        }
+
+    };
+
+}
@@ -0,0 +1,183 @@
+//
+//  query_cache.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace sqlite {
+
+    // Materialized results by query text and result type. An entry is dropped when any table
+    // the statement read is modified, when it expires or when it's the least recently used one.
+
+    class query_cache {
+    public:
+
+        using clock = std::chrono::steady_clock;
+
+        struct statistics {
+            size_t hits = 0;
+            size_t misses = 0;
+            size_t invalidations = 0;
+            size_t evictions = 0;
+        };
+
+    public:
+
+        query_cache(size_t capacity, std::chrono::milliseconds ttl) : m_capacity(capacity), m_ttl(ttl) {}
+
+    public:
+
+        template<class C>
+        std::shared_ptr<const C> get(const std::string &key) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            const auto it = m_entries.find(key);
+            if (it == m_entries.end()) {
+                ++m_statistics.misses;
+                return nullptr;
+            }
+
+            if (it->second.expires < clock::now()) {
+                erase(it);
+                ++m_statistics.evictions;
+                ++m_statistics.misses;
+                return nullptr;
+            }
+
+            m_lru.splice(m_lru.begin(), m_lru, it->second.position);
+            ++m_statistics.hits;
+            return std::static_pointer_cast<const C>(it->second.value);
+        }
+
+        template<class C>
+        void put(const std::string &key, const std::shared_ptr<const C> &value,
+                 const std::unordered_set<std::string> &tables, size_t version) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (version != m_version || m_capacity == 0) {
+                return;
+            }
+
+            const auto existing = m_entries.find(key);
+            if (existing != m_entries.end()) {
+                erase(existing);
+            }
+
+            m_lru.push_front(key);
+            m_entries[key] = {value, tables, clock::now() + m_ttl, m_lru.begin()};
+            for (const auto &table: tables) {
+                m_keys_by_table[table].insert(key);
+            }
+
+            while (m_entries.size() > m_capacity) {
+                erase(m_entries.find(m_lru.back()));
+                ++m_statistics.evictions;
+            }
+        }
+
+        void invalidate(const char *table) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            ++m_version;
+
+            if (m_keys_by_table.empty()) {
+                return;
+            }
+
+            const auto it = m_keys_by_table.find(table);
+            if (it == m_keys_by_table.end()) {
+                return;
+            }
+
+            const auto keys = std::move(it->second);
+            m_keys_by_table.erase(it);
+
+            for (const auto &key: keys) {
+                const auto entry = m_entries.find(key);
+                if (entry != m_entries.end()) {
+                    erase(entry);
+                    ++m_statistics.invalidations;
+                }
+            }
+        }
+
+        void clear() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            ++m_version;
+            m_entries.clear();
+            m_keys_by_table.clear();
+            m_lru.clear();
+        }
+
+        size_t get_version() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_version;
+        }
+
+        statistics get_statistics() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_statistics;
+        }
+
+        size_t size() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_entries.size();
+        }
+
+    private:
+
+        struct entry {
+            std::shared_ptr<const void> value;
+            std::unordered_set<std::string> tables;
+            clock::time_point expires;
+            std::list<std::string>::iterator position;
+        };
+
+    private:
+
+        const size_t m_capacity;
+        const std::chrono::milliseconds m_ttl;
+
+        mutable std::mutex m_mutex;
+
+        std::unordered_map<std::string, entry> m_entries;
+        std::unordered_map<std::string, std::unordered_set<std::string>> m_keys_by_table;
+        std::list<std::string> m_lru;
+
+        size_t m_version = 0;
+
+        statistics m_statistics;
+
+    private:
+
+        void erase(std::unordered_map<std::string, entry>::iterator it) {
+            for (const auto &table: it->second.tables) {
+                const auto keys = m_keys_by_table.find(table);
+                if (keys != m_keys_by_table.end()) {
+                    keys->second.erase(it->first);
+                    if (keys->second.empty()) {
+                        m_keys_by_table.erase(keys);
+                    }
+                }
+            }
+
+            m_lru.erase(it->second.position);
+            m_entries.erase(it);
+        }
+
+    };
+
+}
@@ -0,0 +1,99 @@
+//
+//  read_pool.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "sqlite3.h"
+
+namespace sqlite {
+
+    // Read-only connections to the file of a connection, opened through the same VFS on demand
+    // and kept for reuse. Databases without a file, e.g. in-memory snapshots, have no pool.
+
+    class read_pool {
+    public:
+
+        explicit read_pool(sqlite3 *const db) {
+            sqlite3_vfs *vfs = nullptr;
+            sqlite3_file_control(db, "main", SQLITE_FCNTL_VFS_POINTER, &vfs);
+
+            // Deserialized databases report a made-up file name on the memdb VFS
+
+            const auto filename = sqlite3_db_filename(db, "main");
+            if (filename && *filename && !(vfs && strcmp(vfs->zName, "memdb") == 0)) {
+                m_path = filename;
+                if (vfs) {
+                    m_vfs_name = vfs->zName;
+                }
+            }
+        }
+
+        ~read_pool() {
+            for (const auto db: m_idle) {
+                sqlite3_close(db);
+            }
+        }
+
+        read_pool(const read_pool &) = delete;
+
+        read_pool &operator=(const read_pool &) = delete;
+
+    public:
+
+        bool is_available() const {
+            return !m_path.empty();
+        }
+
+        sqlite3 *acquire() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_idle.empty()) {
+                    const auto db = m_idle.back();
+                    m_idle.pop_back();
+                    return db;
+                }
+            }
+
+            if (!is_available()) {
+                return nullptr;
+            }
+
+            sqlite3 *db = nullptr;
+            const auto vfs_name = m_vfs_name.empty() ? nullptr : m_vfs_name.c_str();
+            if (sqlite3_open_v2(m_path.c_str(), &db, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, vfs_name) !=
+                SQLITE_OK) {
+                sqlite3_close(db);
+                return nullptr;
+            }
+
+            return db;
+        }
+
+        void release(sqlite3 *db) {
+            if (db) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_idle.push_back(db);
+            }
+        }
+
+    private:
+
+        std::string m_path;
+        std::string m_vfs_name;
+
+        std::mutex m_mutex;
+        std::vector<sqlite3 *> m_idle;
+
+    };
+
+}
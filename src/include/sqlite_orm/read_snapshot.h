@@ -0,0 +1,93 @@
+//
+//  read_snapshot.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include "sqlite3.h"
+
+namespace sqlite {
+
+    // One commit of a WAL database shared by read transactions on several connections. The
+    // source connection keeps its read transaction while the snapshot lives, which doesn't block
+    // writers but keeps checkpoints from overwriting the pages of the snapshot.
+    //
+    // Needs SQLite built with SQLITE_ENABLE_SNAPSHOT, sqlite_orm configured with the
+    // SQLITE_ORM_ENABLE_SNAPSHOT option, which defines the macro for every target using it,
+    // and WAL mode. Otherwise it isn't valid and connections read the latest commit.
+
+    class read_snapshot {
+    public:
+
+        explicit read_snapshot(sqlite3 *const db) : m_db(db) {
+#ifdef SQLITE_ORM_ENABLE_SNAPSHOT
+            if (exec(m_db, "BEGIN") && exec(m_db, "SELECT count(*) FROM sqlite_master")) {
+                if (sqlite3_snapshot_get(m_db, "main", &m_snapshot) != SQLITE_OK) {
+                    m_snapshot = nullptr;
+                }
+            }
+
+            if (!m_snapshot) {
+                close(m_db);
+            }
+#endif
+        }
+
+        ~read_snapshot() {
+#ifdef SQLITE_ORM_ENABLE_SNAPSHOT
+            if (m_snapshot) {
+                sqlite3_snapshot_free(m_snapshot);
+                close(m_db);
+            }
+#endif
+        }
+
+        read_snapshot(const read_snapshot &) = delete;
+
+        read_snapshot &operator=(const read_snapshot &) = delete;
+
+    public:
+
+        bool is_valid() const {
+            return m_snapshot != nullptr;
+        }
+
+        // Starts a read transaction on the snapshot, to be finished with close()
+
+        bool open([[maybe_unused]] sqlite3 *db) const {
+#ifdef SQLITE_ORM_ENABLE_SNAPSHOT
+            if (m_snapshot && exec(db, "BEGIN")) {
+                if (sqlite3_snapshot_open(db, "main", m_snapshot) == SQLITE_OK) {
+                    return true;
+                }
+
+                close(db);
+            }
+#endif
+            return false;
+        }
+
+        static void close(sqlite3 *db) {
+            if (!sqlite3_get_autocommit(db)) {
+                exec(db, "COMMIT");
+            }
+        }
+
+    private:
+
+        sqlite3 *const m_db;
+        sqlite3_snapshot *m_snapshot = nullptr;
+
+    private:
+
+        static bool exec(sqlite3 *db, const char *query) {
+            return sqlite3_exec(db, query, nullptr, nullptr, nullptr) == SQLITE_OK;
+        }
+
+    };
+
+}
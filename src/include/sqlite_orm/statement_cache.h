@@ -0,0 +1,195 @@
+//
+//  statement_cache.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "sqlite3.h"
+
+namespace sqlite {
+
+    // Prepared statements by connection and query text. A statement is reset when handed out
+    // again and finalized by release(), which has to precede closing the connection. When reads
+    // is given, the tables reported by the authorizer while preparing are kept with the statement
+    // and added to reads on reuse, since reusing a statement doesn't authorize it again.
+    // Queries carry their other values as literals, so each connection keeps at most capacity
+    // statements and finalizes the least recently used ones that aren't being stepped.
+
+    class statement_cache {
+    public:
+
+        static constexpr size_t capacity = 256;
+
+    public:
+
+        static sqlite3_stmt *get(sqlite3 *db, const std::string &query,
+                                 std::unordered_set<std::string> *reads = nullptr) {
+            std::lock_guard<std::mutex> lock(s_mutex);
+
+            auto &statements = s_statements[db];
+
+            const auto it = statements.entries.find(query);
+            if (it != statements.entries.end()) {
+                auto &entry = it->second;
+                if (!reads || entry.captured) {
+                    statements.order.splice(statements.order.begin(), statements.order, entry.position);
+                    sqlite3_reset(entry.statement);
+                    sqlite3_clear_bindings(entry.statement);
+                    if (reads) {
+                        reads->insert(entry.reads.begin(), entry.reads.end());
+                    }
+                    return entry.statement;
+                }
+
+                // Prepared before reads were captured, so it's prepared again to collect them
+
+                sqlite3_finalize(entry.statement);
+                statements.order.erase(entry.position);
+                statements.entries.erase(it);
+            }
+
+            sqlite3_stmt *statement = nullptr;
+            if (sqlite3_prepare_v3(db, query.c_str(), int(query.size()), SQLITE_PREPARE_PERSISTENT, &statement,
+                                   nullptr) != SQLITE_OK) {
+                sqlite3_finalize(statement);
+                return nullptr;
+            }
+
+            statements.order.push_front(query);
+            entry entry{statement, {}, reads != nullptr, statements.order.begin()};
+            if (reads) {
+                entry.reads = *reads;
+            }
+            statements.entries.emplace(query, std::move(entry));
+
+            evict(statements);
+            return statement;
+        }
+
+        static void release(sqlite3 *db) {
+            std::lock_guard<std::mutex> lock(s_mutex);
+
+            const auto it = s_statements.find(db);
+            if (it == s_statements.end()) {
+                return;
+            }
+
+            for (const auto &[query, entry]: it->second.entries) {
+                sqlite3_finalize(entry.statement);
+            }
+            s_statements.erase(it);
+        }
+
+        // Finalizes the statements whose query names a table or module, e.g. one being replaced.
+        // Statements being stepped are kept.
+
+        static void release(sqlite3 *db, const std::string &name) {
+            std::lock_guard<std::mutex> lock(s_mutex);
+
+            const auto it = s_statements.find(db);
+            if (it == s_statements.end()) {
+                return;
+            }
+
+            auto &statements = it->second;
+            for (auto entry = statements.entries.begin(); entry != statements.entries.end();) {
+                if (sqlite3_stmt_busy(entry->second.statement) || !names(entry->first, name)) {
+                    ++entry;
+                    continue;
+                }
+
+                sqlite3_finalize(entry->second.statement);
+                statements.order.erase(entry->second.position);
+                entry = statements.entries.erase(entry);
+            }
+        }
+
+        static size_t size(sqlite3 *db) {
+            std::lock_guard<std::mutex> lock(s_mutex);
+
+            const auto it = s_statements.find(db);
+            return it == s_statements.end() ? 0 : it->second.entries.size();
+        }
+
+    private:
+
+        struct entry {
+            sqlite3_stmt *statement;
+            std::unordered_set<std::string> reads;
+            bool captured;
+            std::list<std::string>::iterator position;
+        };
+
+        struct connection {
+            std::unordered_map<std::string, entry> entries;
+            std::list<std::string> order;
+        };
+
+    private:
+
+        static void evict(connection &statements) {
+            auto position = statements.order.end();
+            while (statements.entries.size() > capacity && position != statements.order.begin()) {
+                --position;
+
+                const auto it = statements.entries.find(*position);
+                if (sqlite3_stmt_busy(it->second.statement)) {
+                    continue;
+                }
+
+                sqlite3_finalize(it->second.statement);
+                statements.entries.erase(it);
+                position = statements.order.erase(position);
+            }
+        }
+
+        // Whether the query has the name as a whole identifier, ignoring case like SQLite does
+
+        static bool names(const std::string &query, const std::string &name) {
+            const auto identifier = [](char c) {
+                return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+            };
+            const auto equal = [](char a, char b) {
+                return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+            };
+
+            if (name.empty()) {
+                return false;
+            }
+
+            auto position = query.begin();
+            while (true) {
+                position = std::search(position, query.end(), name.begin(), name.end(), equal);
+                if (position == query.end()) {
+                    return false;
+                }
+
+                const auto last = position + name.size();
+                if ((position == query.begin() || !identifier(position[-1])) &&
+                    (last == query.end() || !identifier(*last))) {
+                    return true;
+                }
+                ++position;
+            }
+        }
+
+    private:
+
+        static inline std::mutex s_mutex;
+        static inline std::unordered_map<sqlite3 *, connection> s_statements;
+
+    };
+
+}
@@ -0,0 +1,119 @@
+//
+//  subscription.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "sqlite3.h"
+
+namespace sqlite {
+
+    // Rows of a table changed by one committed transaction. Objects are only loaded for inserted
+    // and updated rows when the subscription asks for them.
+
+    template<class T>
+    struct changes {
+        std::vector<sqlite3_int64> inserted;
+        std::vector<sqlite3_int64> updated;
+        std::vector<sqlite3_int64> deleted;
+        std::unordered_map<sqlite3_int64, std::shared_ptr<T>> objects;
+    };
+
+    // Collapses the row operations of a transaction into one operation per row, e.g. a row
+    // inserted and then updated is reported as inserted, and one inserted and deleted is dropped.
+
+    class change_tracker {
+    public:
+
+        void on_update(int operation, sqlite3_int64 rowid) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            const auto it = m_pending.find(rowid);
+            if (it == m_pending.end()) {
+                m_pending.emplace(rowid, operation);
+                return;
+            }
+
+            auto &pending = it->second;
+            switch (operation) {
+                case SQLITE_INSERT:
+                    if (pending == SQLITE_DELETE) {
+                        pending = SQLITE_UPDATE;
+                    }
+                    break;
+                case SQLITE_UPDATE:
+                    break;
+                case SQLITE_DELETE:
+                    if (pending == SQLITE_INSERT) {
+                        m_pending.erase(it);
+                    } else {
+                        pending = SQLITE_DELETE;
+                    }
+                    break;
+            }
+        }
+
+        void on_transaction(bool committed) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (committed && !m_pending.empty()) {
+                m_committed.push_back(std::move(m_pending));
+            }
+
+            m_pending.clear();
+        }
+
+        template<class T>
+        std::vector<changes<T>> take() {
+            std::vector<std::unordered_map<sqlite3_int64, int>> committed;
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                committed.swap(m_committed);
+            }
+
+            std::vector<changes<T>> result(committed.size());
+            for (size_t i = 0; i < committed.size(); ++i) {
+                auto &changes = result[i];
+                for (const auto &[rowid, operation]: committed[i]) {
+                    switch (operation) {
+                        case SQLITE_INSERT:
+                            changes.inserted.push_back(rowid);
+                            break;
+                        case SQLITE_UPDATE:
+                            changes.updated.push_back(rowid);
+                            break;
+                        case SQLITE_DELETE:
+                            changes.deleted.push_back(rowid);
+                            break;
+                    }
+                }
+
+                std::sort(changes.inserted.begin(), changes.inserted.end());
+                std::sort(changes.updated.begin(), changes.updated.end());
+                std::sort(changes.deleted.begin(), changes.deleted.end());
+            }
+
+            return result;
+        }
+
+    private:
+
+        std::mutex m_mutex;
+
+        std::unordered_map<sqlite3_int64, int> m_pending;
+        std::vector<std::unordered_map<sqlite3_int64, int>> m_committed;
+
+    };
+
+}
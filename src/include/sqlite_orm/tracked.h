@@ -0,0 +1,52 @@
+//
+//  tracked.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <memory>
+
+namespace sqlite {
+
+    // Object with a copy of its last saved state, to tell which fields have been changed since
+
+    template<class T>
+    class tracked {
+    public:
+
+        explicit tracked(const std::shared_ptr<T> &object) : m_object(object), m_original(*object) {}
+
+    public:
+
+        T *operator->() const {
+            return m_object.get();
+        }
+
+        T &operator*() const {
+            return *m_object;
+        }
+
+        const std::shared_ptr<T> &get() const {
+            return m_object;
+        }
+
+        const T &get_original() const {
+            return m_original;
+        }
+
+        void mark_clean() {
+            m_original = *m_object;
+        }
+
+    private:
+
+        std::shared_ptr<T> m_object;
+        T m_original;
+
+    };
+
+}
@@ -0,0 +1,577 @@
+//
+//  compressed_vfs.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <sqlite3.h>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "sqlite_orm/compressed_vfs.h"
+#include "lz4.h"
+#include "mapped_file.h"
+
+namespace sqlite {
+
+    const char *compressed_vfs_name = "compressed_vfs";
+
+    namespace {
+
+        // Layout: magic, version, chunk size, chunk count, database size,
+        // then chunk count + 1 absolute chunk offsets. A chunk whose stored size equals
+        // its decompressed size is kept uncompressed.
+
+        const char magic[4] = {'S', 'Q', 'L', 'Z'};
+        const uint32_t format_version = 1;
+        const size_t header_size = 24;
+
+        const int max_pathname_len = 512;
+        const int sector_size = 512;
+
+        struct compressed_vfs {
+            sqlite3_vfs vfs;
+
+            sqlite3_vfs *base;
+            size_t cache_chunks;
+            size_t prefetch_chunks;
+        };
+
+        void put32(uint8_t *p, uint32_t value) {
+            for (int i = 0; i < 4; ++i) {
+                p[i] = uint8_t(value >> (8 * i));
+            }
+        }
+
+        void put64(uint8_t *p, uint64_t value) {
+            for (int i = 0; i < 8; ++i) {
+                p[i] = uint8_t(value >> (8 * i));
+            }
+        }
+
+        uint32_t get32(const uint8_t *p) {
+            uint32_t value = 0;
+            for (int i = 0; i < 4; ++i) {
+                value |= uint32_t(p[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        uint64_t get64(const uint8_t *p) {
+            uint64_t value = 0;
+            for (int i = 0; i < 8; ++i) {
+                value |= uint64_t(p[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        class chunk_store {
+        public:
+
+            chunk_store(sqlite3_file *file, uint32_t chunk_size, sqlite3_int64 size,
+                        std::vector<sqlite3_int64> offsets, size_t cache_chunks, size_t prefetch_chunks) :
+                    m_file(file), m_chunk_size(chunk_size), m_size(size), m_offsets(std::move(offsets)),
+                    m_cache_chunks(std::max<size_t>(cache_chunks, 1)), m_prefetch_chunks(prefetch_chunks) {
+                const auto threads = std::min<size_t>(prefetch_chunks, std::thread::hardware_concurrency());
+                for (size_t i = 0; i < threads; ++i) {
+                    m_workers.emplace_back(&chunk_store::prefetch, this);
+                }
+            }
+
+            ~chunk_store() {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_stopped = true;
+                }
+                m_queue_condition.notify_all();
+
+                for (auto &worker: m_workers) {
+                    worker.join();
+                }
+
+                m_file->pMethods->xClose(m_file);
+                sqlite3_free(m_file);
+            }
+
+        public:
+
+            sqlite3_int64 size() const {
+                return m_size;
+            }
+
+            int read(void *buf, int amt, sqlite3_int64 offset) {
+                auto out = (uint8_t *) buf;
+
+                const auto end = std::min(offset + amt, m_size);
+                auto position = offset;
+                while (position < end) {
+                    const auto index = size_t(position / m_chunk_size);
+                    const auto chunk = get(index);
+                    if (!chunk) {
+                        return SQLITE_IOERR_READ;
+                    }
+
+                    const auto begin = size_t(position - sqlite3_int64(index) * m_chunk_size);
+                    const auto count = size_t(std::min<sqlite3_int64>(end - position, chunk->size() - begin));
+                    memcpy(out, chunk->data() + begin, count);
+
+                    out += count;
+                    position += count;
+                }
+
+                if (offset + amt > m_size) {
+                    memset(out, 0, size_t(offset + amt - std::max(offset, m_size)));
+                    return SQLITE_IOERR_SHORT_READ;
+                }
+
+                return SQLITE_OK;
+            }
+
+        private:
+
+            using chunk = std::shared_ptr<const std::vector<uint8_t>>;
+
+            struct entry {
+                chunk data;
+                std::list<size_t>::iterator position;
+            };
+
+        private:
+
+            sqlite3_file *const m_file;
+            const uint32_t m_chunk_size;
+            const sqlite3_int64 m_size;
+            const std::vector<sqlite3_int64> m_offsets;
+
+            const size_t m_cache_chunks;
+            const size_t m_prefetch_chunks;
+
+            std::mutex m_file_mutex;
+
+            std::mutex m_mutex;
+            std::condition_variable m_loaded_condition;
+            std::condition_variable m_queue_condition;
+
+            std::unordered_map<size_t, entry> m_cache;
+            std::list<size_t> m_lru;
+
+            std::unordered_set<size_t> m_loading;
+            std::unordered_set<size_t> m_queued;
+            std::deque<size_t> m_queue;
+
+            std::vector<std::thread> m_workers;
+            bool m_stopped = false;
+
+        private:
+
+            chunk get(size_t index) {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                if (!m_workers.empty()) {
+                    schedule(index);
+                }
+
+                while (true) {
+                    if (auto cached = find(index)) {
+                        return cached;
+                    }
+
+                    if (!m_loading.count(index)) {
+                        break;
+                    }
+
+                    m_loaded_condition.wait(lock);
+                }
+
+                m_queued.erase(index);
+                return load_and_insert(index, lock);
+            }
+
+            void schedule(size_t index) {
+                const auto count = m_offsets.size() - 1;
+                for (size_t i = index + 1; i <= index + m_prefetch_chunks && i < count; ++i) {
+                    if (!m_cache.count(i) && !m_loading.count(i) && m_queued.insert(i).second) {
+                        m_queue.push_back(i);
+                        m_queue_condition.notify_one();
+                    }
+                }
+            }
+
+            void prefetch() {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                while (true) {
+                    m_queue_condition.wait(lock, [this] { return m_stopped || !m_queue.empty(); });
+                    if (m_stopped) {
+                        return;
+                    }
+
+                    const auto index = m_queue.front();
+                    m_queue.pop_front();
+
+                    if (m_queued.erase(index) && !m_cache.count(index) && !m_loading.count(index)) {
+                        load_and_insert(index, lock);
+                    }
+                }
+            }
+
+            chunk load_and_insert(size_t index, std::unique_lock<std::mutex> &lock) {
+                m_loading.insert(index);
+
+                lock.unlock();
+                const auto data = load(index);
+                lock.lock();
+
+                m_loading.erase(index);
+                if (data) {
+                    insert(index, data);
+                }
+                m_loaded_condition.notify_all();
+
+                return data;
+            }
+
+            chunk find(size_t index) {
+                const auto it = m_cache.find(index);
+                if (it == m_cache.end()) {
+                    return nullptr;
+                }
+
+                m_lru.splice(m_lru.begin(), m_lru, it->second.position);
+                return it->second.data;
+            }
+
+            void insert(size_t index, const chunk &data) {
+                m_lru.push_front(index);
+                m_cache[index] = {data, m_lru.begin()};
+
+                while (m_cache.size() > m_cache_chunks) {
+                    m_cache.erase(m_lru.back());
+                    m_lru.pop_back();
+                }
+            }
+
+            chunk load(size_t index) {
+                const auto begin = m_offsets[index];
+                const auto stored_size = size_t(m_offsets[index + 1] - begin);
+                const auto length = size_t(std::min<sqlite3_int64>(m_chunk_size,
+                                                                   m_size - sqlite3_int64(index) * m_chunk_size));
+
+                auto data = std::make_shared<std::vector<uint8_t>>(length);
+
+                std::vector<uint8_t> compressed(stored_size == length ? 0 : stored_size);
+                const auto target = compressed.empty() ? data->data() : compressed.data();
+
+                {
+                    std::lock_guard<std::mutex> lock(m_file_mutex);
+                    if (m_file->pMethods->xRead(m_file, target, int(stored_size), begin) != SQLITE_OK) {
+                        return nullptr;
+                    }
+                }
+
+                if (!compressed.empty() &&
+                    lz4_decompress(compressed.data(), stored_size, data->data(), length) != ptrdiff_t(length)) {
+                    return nullptr;
+                }
+
+                return data;
+            }
+
+        };
+
+        struct compressed_file {
+            const sqlite3_io_methods *methods;
+            chunk_store *store;
+        };
+
+    }
+
+    static int compressed_file_close(sqlite3_file *file) {
+        auto compressed_file = (sqlite::compressed_file *) file;
+
+        delete compressed_file->store;
+        compressed_file->store = nullptr;
+
+        return SQLITE_OK;
+    }
+
+    static int compressed_file_read(sqlite3_file *file, void *buf, int amt, sqlite3_int64 offset) {
+        const auto compressed_file = (sqlite::compressed_file *) file;
+        if (!compressed_file->store) {
+            return SQLITE_IOERR_READ;
+        }
+
+        return compressed_file->store->read(buf, amt, offset);
+    }
+
+    static int compressed_file_write(sqlite3_file *, const void *, int, sqlite3_int64) {
+        return SQLITE_IOERR_WRITE;
+    }
+
+    static int compressed_file_truncate(sqlite3_file *, sqlite3_int64) {
+        return SQLITE_IOERR_TRUNCATE;
+    }
+
+    static int compressed_file_sync(sqlite3_file *, int) {
+        return SQLITE_IOERR_FSYNC;
+    }
+
+    static int compressed_file_size(sqlite3_file *file, sqlite3_int64 *size) {
+        const auto compressed_file = (sqlite::compressed_file *) file;
+        *size = compressed_file->store ? compressed_file->store->size() : 0;
+
+        return SQLITE_OK;
+    }
+
+    static int compressed_file_lock(sqlite3_file *, int) {
+        return SQLITE_OK;
+    }
+
+    static int compressed_file_unlock(sqlite3_file *, int) {
+        return SQLITE_OK;
+    }
+
+    static int compressed_file_check_reserved_lock(sqlite3_file *, int *res) {
+        *res = 0;
+        return SQLITE_OK;
+    }
+
+    static int compressed_file_control(sqlite3_file *, int, void *) {
+        return SQLITE_NOTFOUND;
+    }
+
+    static int compressed_file_sector_size(sqlite3_file *) {
+        return sector_size;
+    }
+
+    static int compressed_file_device_characteristics(sqlite3_file *) {
+        return SQLITE_IOCAP_IMMUTABLE;
+    }
+
+    static const sqlite3_io_methods compressed_file_methods = {
+            1,
+            compressed_file_close,
+            compressed_file_read,
+            compressed_file_write,
+            compressed_file_truncate,
+            compressed_file_sync,
+            compressed_file_size,
+            compressed_file_lock,
+            compressed_file_unlock,
+            compressed_file_check_reserved_lock,
+            compressed_file_control,
+            compressed_file_sector_size,
+            compressed_file_device_characteristics,
+            nullptr,
+            nullptr,
+            nullptr,
+            nullptr,
+            nullptr,
+            nullptr
+    };
+
+    static chunk_store *open_store(const compressed_vfs *vfs, sqlite3_file *base_file) {
+        const auto read = [base_file](void *buf, size_t size, sqlite3_int64 offset) {
+            return base_file->pMethods->xRead(base_file, buf, int(size), offset) == SQLITE_OK;
+        };
+
+        uint8_t header[header_size];
+        if (!read(header, header_size, 0) || memcmp(header, magic, sizeof(magic)) != 0 ||
+            get32(header + 4) != format_version) {
+            return nullptr;
+        }
+
+        const auto chunk_size = get32(header + 8);
+        const auto chunk_count = get32(header + 12);
+        const auto size = sqlite3_int64(get64(header + 16));
+        if (chunk_size == 0 || size < 0 || (size + chunk_size - 1) / chunk_size != chunk_count) {
+            return nullptr;
+        }
+
+        std::vector<uint8_t> index((size_t(chunk_count) + 1) * 8);
+        if (!read(index.data(), index.size(), header_size)) {
+            return nullptr;
+        }
+
+        std::vector<sqlite3_int64> offsets(size_t(chunk_count) + 1);
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            offsets[i] = sqlite3_int64(get64(index.data() + i * 8));
+            if (i > 0 && offsets[i] < offsets[i - 1]) {
+                return nullptr;
+            }
+        }
+
+        return new chunk_store(base_file, chunk_size, size, std::move(offsets), vfs->cache_chunks,
+                               vfs->prefetch_chunks);
+    }
+
+    static int compressed_open(sqlite3_vfs *vfs, const char *path, sqlite3_file *file, int flags, int *out_flags) {
+        const auto compressed_vfs = (sqlite::compressed_vfs *) vfs;
+        auto compressed_file = (sqlite::compressed_file *) file;
+
+        compressed_file->methods = nullptr;
+        compressed_file->store = nullptr;
+
+        if (!path) {
+            return SQLITE_PERM;
+        }
+
+        if (!is_read_only_main_db(flags)) {
+            return SQLITE_PERM;
+        }
+
+        const auto base = compressed_vfs->base;
+        auto base_file = (sqlite3_file *) sqlite3_malloc(base->szOsFile);
+        if (!base_file) {
+            return SQLITE_NOMEM;
+        }
+        memset(base_file, 0, size_t(base->szOsFile));
+
+        const auto rc = base->xOpen(base, path, base_file, flags, nullptr);
+        if (rc == SQLITE_OK) {
+            compressed_file->store = open_store(compressed_vfs, base_file);
+        }
+
+        if (!compressed_file->store) {
+            if (base_file->pMethods) {
+                base_file->pMethods->xClose(base_file);
+            }
+            sqlite3_free(base_file);
+            return rc == SQLITE_OK ? SQLITE_NOTADB : rc;
+        }
+
+        compressed_file->methods = &compressed_file_methods;
+
+        if (out_flags) {
+            *out_flags = flags;
+        }
+
+        return SQLITE_OK;
+    }
+
+    static int compressed_access(sqlite3_vfs *vfs, const char *path, int flags, int *res_out) {
+        const auto base = ((sqlite::compressed_vfs *) vfs)->base;
+        return base->xAccess(base, path, flags, res_out);
+    }
+
+    static int compressed_full_pathname(sqlite3_vfs *vfs, const char *path, int out_len, char *out) {
+        const auto base = ((sqlite::compressed_vfs *) vfs)->base;
+        return base->xFullPathname(base, path, out_len, out);
+    }
+
+    int register_compressed_vfs(const char *name, const char *base_vfs_name, size_t cache_chunks,
+                                size_t prefetch_chunks) {
+        static sqlite::compressed_vfs compressed_vfs;
+
+        if (strlen(name) >= max_pathname_len) {
+            return SQLITE_ERROR;
+        }
+
+        const auto base = sqlite3_vfs_find(base_vfs_name);
+        if (!base || base == &compressed_vfs.vfs) {
+            return SQLITE_ERROR;
+        }
+
+        if (compressed_vfs.base) {
+            sqlite3_vfs_unregister(&compressed_vfs.vfs);
+        }
+
+        //
+
+        compressed_vfs.base = base;
+        compressed_vfs.cache_chunks = cache_chunks;
+        compressed_vfs.prefetch_chunks = prefetch_chunks;
+
+        init_mapped_vfs(compressed_vfs.vfs, name, std::max(max_pathname_len, base->mxPathname), compressed_open,
+                        compressed_access);
+        compressed_vfs.vfs.szOsFile = sizeof(compressed_file);
+        compressed_vfs.vfs.pAppData = base;
+        compressed_vfs.vfs.xFullPathname = compressed_full_pathname;
+
+        //
+
+        const auto result = sqlite3_vfs_register(&compressed_vfs.vfs, 0);
+
+        if (result != SQLITE_OK) {
+            compressed_vfs.base = nullptr;
+        }
+
+        return result;
+    }
+
+    bool pack_database(const std::string &source, const std::string &destination, size_t chunk_size) {
+        if (chunk_size == 0 || chunk_size > UINT32_MAX) {
+            return false;
+        }
+
+        sqlite3 *db = nullptr;
+        sqlite3_open_v2(source.c_str(), &db, SQLITE_OPEN_READONLY, nullptr);
+
+        sqlite3_int64 size = 0;
+        const auto data = sqlite3_serialize(db, "main", &size, 0);
+        sqlite3_close(db);
+
+        if (!data) {
+            return false;
+        }
+
+        // The packed database is read-only and can't have a -wal file
+
+        if (size > 19 && data[18] == 2) {
+            data[18] = 1;
+            data[19] = 1;
+        }
+
+        const auto chunk_count = size_t((size + sqlite3_int64(chunk_size) - 1) / sqlite3_int64(chunk_size));
+
+        std::vector<uint8_t> header(header_size + (chunk_count + 1) * 8);
+        memcpy(header.data(), magic, sizeof(magic));
+        put32(header.data() + 4, format_version);
+        put32(header.data() + 8, uint32_t(chunk_size));
+        put32(header.data() + 12, uint32_t(chunk_count));
+        put64(header.data() + 16, uint64_t(size));
+
+        std::ofstream file(destination, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(header.data()), std::streamsize(header.size()));
+
+        std::vector<uint8_t> buffer(lz4_compress_bound(chunk_size));
+        auto offset = uint64_t(header.size());
+        for (size_t i = 0; i < chunk_count; ++i) {
+            put64(header.data() + header_size + i * 8, offset);
+
+            const auto chunk = data + i * chunk_size;
+            const auto length = size_t(std::min<sqlite3_int64>(sqlite3_int64(chunk_size),
+                                                               size - sqlite3_int64(i * chunk_size)));
+
+            const auto compressed_size = lz4_compress(chunk, length, buffer.data(), buffer.size());
+            if (compressed_size == 0 || compressed_size >= length) {
+                file.write(reinterpret_cast<const char *>(chunk), std::streamsize(length));
+                offset += length;
+            } else {
+                file.write(reinterpret_cast<const char *>(buffer.data()), std::streamsize(compressed_size));
+                offset += compressed_size;
+            }
+        }
+        put64(header.data() + header_size + chunk_count * 8, offset);
+
+        sqlite3_free(data);
+
+        file.seekp(0);
+        file.write(reinterpret_cast<const char *>(header.data()), std::streamsize(header.size()));
+
+        return bool(file);
+    }
+
+}
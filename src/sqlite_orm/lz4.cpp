@@ -0,0 +1,209 @@
+//
+//  lz4.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cstring>
+#include <vector>
+
+#include "lz4.h"
+
+namespace sqlite {
+
+    namespace {
+
+        const size_t min_match = 4;
+        const size_t last_literals = 5;
+        const size_t match_find_limit = 12;
+        const size_t max_offset = 65535;
+
+        const int hash_log = 12;
+
+        inline uint32_t read32(const uint8_t *p) {
+            uint32_t value;
+            memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        inline uint32_t hash(uint32_t sequence) {
+            return (sequence * 2654435761u) >> (32 - hash_log);
+        }
+
+        inline bool write_length(size_t length, uint8_t *&op, const uint8_t *const end) {
+            for (; length >= 255; length -= 255) {
+                if (op >= end) {
+                    return false;
+                }
+                *op++ = 255;
+            }
+
+            if (op >= end) {
+                return false;
+            }
+            *op++ = uint8_t(length);
+
+            return true;
+        }
+
+        inline bool write_sequence(const uint8_t *literals, size_t literal_length, size_t offset, size_t match_length,
+                                   uint8_t *&op, const uint8_t *const end) {
+            if (op >= end) {
+                return false;
+            }
+
+            auto token = op++;
+            *token = uint8_t((literal_length < 15 ? literal_length : 15) << 4);
+            if (literal_length >= 15 && !write_length(literal_length - 15, op, end)) {
+                return false;
+            }
+
+            if (size_t(end - op) < literal_length) {
+                return false;
+            }
+            memcpy(op, literals, literal_length);
+            op += literal_length;
+
+            if (match_length == 0) {
+                return true;
+            }
+
+            if (end - op < 2) {
+                return false;
+            }
+            *op++ = uint8_t(offset);
+            *op++ = uint8_t(offset >> 8);
+
+            const auto length = match_length - min_match;
+            *token |= uint8_t(length < 15 ? length : 15);
+            return length < 15 || write_length(length - 15, op, end);
+        }
+
+        inline bool read_length(size_t &length, const uint8_t *&ip, const uint8_t *const end) {
+            uint8_t byte;
+            do {
+                if (ip >= end) {
+                    return false;
+                }
+                byte = *ip++;
+                length += byte;
+            } while (byte == 255);
+
+            return true;
+        }
+
+    }
+
+    size_t lz4_compress_bound(size_t size) {
+        return size + size / 255 + 16;
+    }
+
+    size_t lz4_compress(const uint8_t *src, size_t size, uint8_t *dst, size_t capacity) {
+        auto op = dst;
+        const auto op_end = dst + capacity;
+
+        size_t anchor = 0;
+
+        if (size > match_find_limit) {
+            std::vector<uint32_t> table(size_t(1) << hash_log, 0);
+
+            const auto limit = size - match_find_limit;
+            const auto match_limit = size - last_literals;
+
+            size_t ip = 0;
+            while (ip < limit) {
+                const auto sequence = read32(src + ip);
+                auto &entry = table[hash(sequence)];
+                const size_t ref = entry;
+                entry = uint32_t(ip + 1);
+
+                if (ref == 0 || ip - (ref - 1) > max_offset || read32(src + ref - 1) != sequence) {
+                    ++ip;
+                    continue;
+                }
+
+                const auto match = ref - 1;
+                auto length = min_match;
+                while (ip + length < match_limit && src[match + length] == src[ip + length]) {
+                    ++length;
+                }
+
+                if (!write_sequence(src + anchor, ip - anchor, ip - match, length, op, op_end)) {
+                    return 0;
+                }
+
+                ip += length;
+                anchor = ip;
+            }
+        }
+
+        if (!write_sequence(src + anchor, size - anchor, 0, 0, op, op_end)) {
+            return 0;
+        }
+
+        return size_t(op - dst);
+    }
+
+    ptrdiff_t lz4_decompress(const uint8_t *src, size_t size, uint8_t *dst, size_t capacity) {
+        auto ip = src;
+        const auto ip_end = src + size;
+
+        auto op = dst;
+        const auto op_end = dst + capacity;
+
+        while (ip < ip_end) {
+            const auto token = *ip++;
+
+            size_t literal_length = token >> 4;
+            if (literal_length == 15 && !read_length(literal_length, ip, ip_end)) {
+                return -1;
+            }
+
+            if (size_t(ip_end - ip) < literal_length || size_t(op_end - op) < literal_length) {
+                return -1;
+            }
+            memcpy(op, ip, literal_length);
+            ip += literal_length;
+            op += literal_length;
+
+            if (ip == ip_end) {
+                break;
+            }
+
+            if (ip_end - ip < 2) {
+                return -1;
+            }
+            const size_t offset = ip[0] | (size_t(ip[1]) << 8);
+            ip += 2;
+
+            if (offset == 0 || offset > size_t(op - dst)) {
+                return -1;
+            }
+
+            size_t match_length = token & 15;
+            if (match_length == 15 && !read_length(match_length, ip, ip_end)) {
+                return -1;
+            }
+            match_length += min_match;
+
+            if (size_t(op_end - op) < match_length) {
+                return -1;
+            }
+
+            const auto match = op - offset;
+            if (offset >= match_length) {
+                memcpy(op, match, match_length);
+            } else {
+                for (size_t i = 0; i < match_length; ++i) {
+                    op[i] = match[i];
+                }
+            }
+            op += match_length;
+        }
+
+        return op - dst;
+    }
+
+}
@@ -0,0 +1,26 @@
+//
+//  lz4.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sqlite {
+
+    // LZ4 block format, compatible with LZ4_compress_default / LZ4_decompress_safe.
+
+    size_t lz4_compress_bound(size_t size);
+
+    // Returns the compressed size, or 0 when the output doesn't fit into capacity.
+    size_t lz4_compress(const uint8_t *src, size_t size, uint8_t *dst, size_t capacity);
+
+    // Returns the decompressed size, or -1 for malformed input.
+    ptrdiff_t lz4_decompress(const uint8_t *src, size_t size, uint8_t *dst, size_t capacity);
+
+}
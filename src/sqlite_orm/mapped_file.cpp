@@ -0,0 +1,234 @@
+//
+//  mapped_file.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cstring>
+
+#include "mapped_file.h"
+
+namespace sqlite {
+
+    namespace {
+
+        const int sector_size = 512;
+
+    }
+
+    static int mapped_file_close(sqlite3_file *file) {
+        auto mapped_file = (sqlite::mapped_file *) file;
+
+        if (mapped_file->handle) {
+            mapped_file->release(mapped_file);
+            mapped_file->handle = nullptr;
+            mapped_file->buf = nullptr;
+            mapped_file->len = 0;
+        }
+
+        return SQLITE_OK;
+    }
+
+    static int mapped_file_read(sqlite3_file *file, void *buf, int amt, sqlite3_int64 offset) {
+        const auto mapped_file = (sqlite::mapped_file *) file;
+        if (mapped_file->handle == nullptr) {
+            return SQLITE_IOERR_READ;
+        }
+
+        sqlite3_int64 got;
+        int rc;
+
+        if (offset + amt <= mapped_file->len) {
+            got = amt;
+            rc = SQLITE_OK;
+        } else {
+            got = mapped_file->len - offset;
+            if (got < 0) {
+                rc = SQLITE_IOERR_READ;
+            } else {
+                rc = SQLITE_IOERR_SHORT_READ;
+                memset(&((char *) buf)[got], 0, size_t(amt - got));
+            }
+        }
+
+        if (got > 0) {
+            memcpy(buf, (const char *) mapped_file->buf + offset, size_t(got));
+        }
+
+        return rc;
+    }
+
+    static int mapped_file_write(sqlite3_file *, const void *, int, sqlite3_int64) {
+        return SQLITE_IOERR_WRITE;
+    }
+
+    static int mapped_file_truncate(sqlite3_file *, sqlite3_int64) {
+        return SQLITE_IOERR_TRUNCATE;
+    }
+
+    static int mapped_file_sync(sqlite3_file *, int) {
+        return SQLITE_IOERR_FSYNC;
+    }
+
+    static int mapped_file_size(sqlite3_file *file, sqlite3_int64 *size) {
+        const auto mapped_file = (sqlite::mapped_file *) file;
+        *size = mapped_file->len;
+
+        return SQLITE_OK;
+    }
+
+    static int mapped_file_lock(sqlite3_file *, int) {
+        return SQLITE_OK;
+    }
+
+    static int mapped_file_unlock(sqlite3_file *, int) {
+        return SQLITE_OK;
+    }
+
+    static int mapped_file_check_reserved_lock(sqlite3_file *, int *res) {
+        *res = 0;
+        return SQLITE_OK;
+    }
+
+    static int mapped_file_control(sqlite3_file *file, int op, void *arg) {
+        auto mapped_file = (sqlite::mapped_file *) file;
+
+        switch (op) {
+            case SQLITE_FCNTL_MMAP_SIZE: {
+                const auto limit = *(sqlite3_int64 *) arg;
+                *(sqlite3_int64 *) arg = mapped_file->mmap_size;
+                if (limit >= 0) {
+                    mapped_file->mmap_size = limit;
+                }
+                return SQLITE_OK;
+            }
+            default:
+                return SQLITE_NOTFOUND;
+        }
+    }
+
+    static int mapped_file_sector_size(sqlite3_file *) {
+        return sector_size;
+    }
+
+    static int mapped_file_device_characteristics(sqlite3_file *) {
+        return SQLITE_IOCAP_IMMUTABLE;
+    }
+
+    static int mapped_file_fetch(sqlite3_file *file, sqlite3_int64 offset, int amt, void **p) {
+        const auto mapped_file = (sqlite::mapped_file *) file;
+
+        if (mapped_file->buf && offset >= 0 &&
+            offset + amt <= mapped_file->len && offset + amt <= mapped_file->mmap_size) {
+            *p = (char *) mapped_file->buf + offset;
+        } else {
+            *p = nullptr;
+        }
+
+        return SQLITE_OK;
+    }
+
+    static int mapped_file_unfetch(sqlite3_file *, sqlite3_int64, void *) {
+        return SQLITE_OK;
+    }
+
+    const sqlite3_io_methods mapped_file_methods = {
+            3,
+            mapped_file_close,
+            mapped_file_read,
+            mapped_file_write,
+            mapped_file_truncate,
+            mapped_file_sync,
+            mapped_file_size,
+            mapped_file_lock,
+            mapped_file_unlock,
+            mapped_file_check_reserved_lock,
+            mapped_file_control,
+            mapped_file_sector_size,
+            mapped_file_device_characteristics,
+            nullptr,
+            nullptr,
+            nullptr,
+            nullptr,
+            mapped_file_fetch,
+            mapped_file_unfetch
+    };
+
+    bool is_read_only_main_db(int flags) {
+        return (flags & SQLITE_OPEN_READONLY) &&
+               (flags & SQLITE_OPEN_MAIN_DB) &&
+               !(flags & SQLITE_OPEN_DELETEONCLOSE) &&
+               !(flags & SQLITE_OPEN_READWRITE) &&
+               !(flags & SQLITE_OPEN_CREATE);
+    }
+
+    //
+
+    static int mapped_delete(sqlite3_vfs *, const char *, int) {
+        return SQLITE_ERROR;
+    }
+
+    static int mapped_full_pathname(sqlite3_vfs *, const char *path, int out_len, char *out) {
+        if (!path || !out) {
+            return SQLITE_ERROR;
+        }
+
+        sqlite3_snprintf(out_len, out, "%s", path);
+
+        return SQLITE_OK;
+    }
+
+    static int mapped_randomness(sqlite3_vfs *vfs, int buf_len, char *buf) {
+        const auto vfs_default = (sqlite3_vfs *) vfs->pAppData;
+        return vfs_default->xRandomness(vfs_default, buf_len, buf);
+    }
+
+    static int mapped_sleep(sqlite3_vfs *vfs, int microseconds) {
+        const auto vfs_default = (sqlite3_vfs *) vfs->pAppData;
+        return vfs_default->xSleep(vfs_default, microseconds);
+    }
+
+    static int mapped_current_time(sqlite3_vfs *vfs, double *now) {
+        const auto vfs_default = (sqlite3_vfs *) vfs->pAppData;
+        return vfs_default->xCurrentTime(vfs_default, now);
+    }
+
+    static int mapped_current_time_int_64(sqlite3_vfs *vfs, sqlite3_int64 *now) {
+        const auto vfs_default = (sqlite3_vfs *) vfs->pAppData;
+        return vfs_default->xCurrentTimeInt64(vfs_default, now);
+    }
+
+    static int mapped_get_last_error(sqlite3_vfs *, int, char *) {
+        return 0;
+    }
+
+    void init_mapped_vfs(sqlite3_vfs &vfs, const char *name, int max_pathname_len,
+                         int (*open)(sqlite3_vfs *, const char *, sqlite3_file *, int, int *),
+                         int (*access)(sqlite3_vfs *, const char *, int, int *)) {
+        vfs.iVersion = 3;
+        vfs.szOsFile = sizeof(mapped_file);
+        vfs.mxPathname = max_pathname_len;
+        vfs.pNext = nullptr;
+        vfs.zName = name;
+        vfs.pAppData = sqlite3_vfs_find(nullptr);
+        vfs.xOpen = open;
+        vfs.xDelete = mapped_delete;
+        vfs.xAccess = access;
+        vfs.xFullPathname = mapped_full_pathname;
+        vfs.xDlOpen = nullptr;
+        vfs.xDlError = nullptr;
+        vfs.xDlSym = nullptr;
+        vfs.xDlClose = nullptr;
+        vfs.xRandomness = mapped_randomness;
+        vfs.xSleep = mapped_sleep;
+        vfs.xCurrentTime = mapped_current_time;
+        vfs.xGetLastError = mapped_get_last_error;
+        vfs.xCurrentTimeInt64 = mapped_current_time_int_64;
+        vfs.xSetSystemCall = nullptr;
+        vfs.xGetSystemCall = nullptr;
+        vfs.xNextSystemCall = nullptr;
+    }
+
+}
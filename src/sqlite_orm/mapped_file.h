@@ -0,0 +1,34 @@
+//
+//  mapped_file.h
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#pragma once
+
+#include <sqlite3.h>
+
+namespace sqlite {
+
+    // Read-only database file backed by a buffer that stays mapped while the file is open.
+
+    struct mapped_file {
+        const sqlite3_io_methods *methods;
+        const void *buf;
+        sqlite3_int64 len;
+        sqlite3_int64 mmap_size;
+        void *handle;
+        void (*release)(mapped_file *file);
+    };
+
+    extern const sqlite3_io_methods mapped_file_methods;
+
+    bool is_read_only_main_db(int flags);
+
+    void init_mapped_vfs(sqlite3_vfs &vfs, const char *name, int max_pathname_len,
+                         int (*open)(sqlite3_vfs *, const char *, sqlite3_file *, int, int *),
+                         int (*access)(sqlite3_vfs *, const char *, int, int *));
+
+}
@@ -0,0 +1,134 @@
+//
+//  mmap_vfs.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstring>
+#include <fcntl.h>
+#include <sqlite3.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "sqlite_orm/mmap_vfs.h"
+#include "mapped_file.h"
+
+namespace sqlite {
+
+    const char *mmap_vfs_name = "mmap_vfs";
+
+    namespace {
+
+        const int max_pathname_len = 512;
+
+        const char empty_file[1] = {};
+
+    }
+
+    static void mmap_release(mapped_file *file) {
+        if (file->len > 0) {
+            munmap(file->handle, size_t(file->len));
+        }
+    }
+
+    static int mmap_open(sqlite3_vfs *, const char *path, sqlite3_file *file, int flags, int *out_flags) {
+        auto mapped_file = (sqlite::mapped_file *) file;
+
+        mapped_file->methods = nullptr;
+
+        if (!path) {
+            return SQLITE_PERM;
+        }
+
+        if (!is_read_only_main_db(flags)) {
+            return SQLITE_PERM;
+        }
+
+        const auto fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            return SQLITE_CANTOPEN;
+        }
+
+        struct stat st {};
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            return SQLITE_IOERR_FSTAT;
+        }
+
+        void *buf = (void *) empty_file;
+        if (st.st_size > 0) {
+            buf = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+
+        if (buf == MAP_FAILED) {
+            return SQLITE_IOERR_MMAP;
+        }
+
+        mapped_file->methods = &mapped_file_methods;
+        mapped_file->buf = buf;
+        mapped_file->len = st.st_size;
+        mapped_file->mmap_size = 0;
+        mapped_file->handle = buf;
+        mapped_file->release = mmap_release;
+
+        if (out_flags) {
+            *out_flags = flags;
+        }
+
+        return SQLITE_OK;
+    }
+
+    static int mmap_access(sqlite3_vfs *, const char *path, int flags, int *res_out) {
+        *res_out = 0;
+
+        switch (flags) {
+            case SQLITE_ACCESS_EXISTS:
+            case SQLITE_ACCESS_READ:
+                *res_out = access(path, R_OK) == 0;
+                break;
+            default:
+                break;
+        }
+
+        return SQLITE_OK;
+    }
+
+    int register_mmap_vfs(const char *name) {
+        static sqlite3_vfs mmap_vfs;
+
+        if (strlen(name) >= max_pathname_len) {
+            return SQLITE_ERROR;
+        }
+
+        if (mmap_vfs.zName) {
+            sqlite3_vfs_unregister(&mmap_vfs);
+        }
+
+        //
+
+        init_mapped_vfs(mmap_vfs, name, max_pathname_len, mmap_open, mmap_access);
+        if (!mmap_vfs.pAppData) {
+            mmap_vfs.zName = nullptr;
+            return SQLITE_ERROR;
+        }
+
+        //
+
+        const auto result = sqlite3_vfs_register(&mmap_vfs, 0);
+
+        if (result != SQLITE_OK) {
+            mmap_vfs.zName = nullptr;
+        }
+
+        return result;
+    }
+
+}
+
+#endif
@@ -0,0 +1,147 @@
+//
+//  test_aggregates.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int group;
+        int number;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *table = "test_aggregates";
+        const int count = 100;
+        const int groups = 4;
+        const int large = 2000000000;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db_with_data() {
+        auto db = sqlite::database<data>::open("test.db");
+        db->set_fields({{&data::id,     "id"},
+                        {&data::group,  "group_id"},
+                        {&data::number, "number"},
+                        {&data::text,   "text"}});
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+        *db << DELETE << FROM << constant::table << ';';
+
+        *db << BEGIN_TRANSACTION << ';';
+        for (int i = 1; i <= constant::count; ++i) {
+            const auto object = std::make_shared<data>(data{0, i % constant::groups, i, "group " +
+                                                                                        std::to_string(i % constant::groups)});
+            *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << i << object << ')' << ';';
+        }
+        *db << COMMIT << ';';
+
+        return db;
+    }
+
+}
+
+int main() {
+    auto db = create_db_with_data();
+
+    // Scalars
+
+    {
+        *db << SELECT << SUM << '(' << &data::number << ')' << FROM << constant::table;
+        const int64_t sum = *db;
+        assert(sum == constant::count * (constant::count + 1) / 2);
+
+        *db << SELECT << MIN << '(' << &data::number << ')' << FROM << constant::table;
+        assert(int(*db) == 1);
+
+        *db << SELECT << MAX << '(' << &data::number << ')' << FROM << constant::table;
+        assert(int(*db) == constant::count);
+
+        *db << SELECT << AVG << '(' << &data::number << ')' << FROM << constant::table;
+        const double average = *db;
+        assert(average == (constant::count + 1) / 2.0);
+
+        *db << SELECT << MAX << '(' << &data::text << ')' << FROM << constant::table;
+        const std::string text = *db;
+        assert(text == "group 3");
+
+        *db << SELECT << COUNT << FROM << constant::table;
+        assert(int(*db) == constant::count);
+    }
+
+    // 64-bit results
+
+    {
+        *db << UPDATE << constant::table << SET << &data::number << EQUALS << constant::large << ';';
+
+        *db << SELECT << SUM << '(' << &data::number << ')' << FROM << constant::table;
+        const int64_t sum = *db;
+        assert(sum == int64_t(constant::large) * constant::count);
+
+        db = create_db_with_data();
+    }
+
+    // Groups
+
+    {
+        *db << SELECT << &data::group << ',' << SUM << '(' << &data::number << ')'
+            << FROM << constant::table << GROUP_BY << &data::group;
+
+        std::unordered_map<int, int64_t> sums;
+        *db >> sums;
+        assert(sums.size() == constant::groups);
+
+        int64_t total = 0;
+        for (const auto &[group, sum]: sums) {
+            total += sum;
+        }
+        assert(total == constant::count * (constant::count + 1) / 2);
+        assert(sums.at(0) == 4 + 8 + 12 + 16 + 20 + 24 + 28 + 32 + 36 + 40 + 44 + 48 + 52 + 56 + 60 + 64 + 68 + 72 +
+                             76 + 80 + 84 + 88 + 92 + 96 + 100);
+
+        *db << SELECT << &data::text << ',' << AVG << '(' << &data::number << ')'
+            << FROM << constant::table << GROUP_BY << &data::text;
+
+        std::unordered_map<std::string, double> averages;
+        *db >> averages;
+        assert(averages.size() == constant::groups);
+        assert(averages.at("group 1") == 49.0);
+    }
+
+    // Tuples
+
+    {
+        *db << SELECT << &data::group << ',' << COUNT << ',' << MIN << '(' << &data::number << ')' << ','
+            << MAX << '(' << &data::text << ')' << FROM << constant::table
+            << GROUP_BY << &data::group << ORDER_BY << &data::group;
+
+        std::vector<std::tuple<int, size_t, int, std::string>> rows;
+        *db >> rows;
+        assert(rows.size() == constant::groups);
+
+        const auto &[group, count, min, text] = rows[1];
+        assert(group == 1);
+        assert(count == constant::count / constant::groups);
+        assert(min == 1);
+        assert(text == "group 1");
+    }
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+//
+//  test_backup.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <atomic>
+#include <cassert>
+#include <string>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *db_name = "test_backup.db";
+        const char *backup_db_name = "test_backup_copy.db";
+        const char *table = "test_backup";
+        const size_t count = 200;
+        const size_t extra_count = 5;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> open(const char *path) {
+        auto db = sqlite::database<data>::open(path);
+        db->set_fields({{&data::id,   "id"},
+                        {&data::text, "text"}});
+        return db;
+    }
+
+    void insert(const std::shared_ptr<sqlite::database<data>> &db) {
+        const auto object = std::make_shared<data>(data{0, std::string(500, 'a')});
+        *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+            << VALUES << '(' << "null" << object << ')' << ';';
+    }
+
+}
+
+int main() {
+    std::remove(constant::db_name);
+    std::remove(constant::backup_db_name);
+
+    auto db = open(constant::db_name);
+
+    *db << PRAGMA << "journal_mode = WAL";
+    const std::vector<std::string> journal_mode = *db;
+    assert(journal_mode.front() == "wal");
+
+    *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+    *db << BEGIN_TRANSACTION << ';';
+    for (size_t i = 0; i < constant::count; ++i) {
+        insert(db);
+    }
+    *db << COMMIT << ';';
+
+    // Backup with concurrent writes
+
+    std::atomic<int> steps{0};
+    const auto backup = db->backup_to(constant::backup_db_name, 1, std::chrono::milliseconds(1),
+                                      [&](int remaining, int page_count) {
+                                          assert(remaining <= page_count);
+                                          ++steps;
+                                      });
+
+    for (size_t i = 0; i < constant::extra_count; ++i) {
+        insert(db);
+    }
+    assert(db->get_last_errors().empty());
+
+    assert(backup->wait() == SQLITE_OK);
+    assert(backup->is_done());
+    assert(steps > 1);
+
+    {
+        auto copy = open(constant::backup_db_name);
+        *copy << SELECT << COUNT << FROM << constant::table;
+        const size_t count = *copy;
+        assert(count >= constant::count && count <= constant::count + constant::extra_count);
+    }
+
+    // Cancel
+
+    {
+        const auto cancelled = db->backup_to(constant::backup_db_name, 1, std::chrono::milliseconds(100));
+        cancelled->cancel();
+        assert(cancelled->wait() == SQLITE_INTERRUPT);
+    }
+
+    sqlite::database<data>::clear_cache();
+
+    return 0;
+}
@@ -0,0 +1,161 @@
+//
+//  test_bound_list.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <string>
+#include <unordered_set>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int number;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *table = "test_bound_list";
+        const int count = 1000;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db_with_data() {
+        auto db = sqlite::database<data>::open("test.db");
+        db->set_fields({{&data::id,     "id"},
+                        {&data::number, "number"},
+                        {&data::text,   "text"}});
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+        *db << DELETE << FROM << constant::table << ';';
+
+        *db << BEGIN_TRANSACTION << ';';
+        for (int i = 1; i <= constant::count; ++i) {
+            const auto object = std::make_shared<data>(data{0, i, "text " + std::to_string(i)});
+            *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << i << object << ')' << ';';
+        }
+        *db << COMMIT << ';';
+
+        return db;
+    }
+
+}
+
+int main() {
+    auto db = create_db_with_data();
+
+    // Lookups
+
+    {
+        std::vector<int> ids;
+        for (int i = 2; i <= constant::count; i += 2) {
+            ids.push_back(i);
+        }
+
+        *db << SELECT << ALL << FROM << constant::table << WHERE << &data::id << IN << bind_list(ids);
+        const std::vector<std::shared_ptr<data>> objects = *db;
+        assert(objects.size() == ids.size());
+        for (const auto &object: objects) {
+            assert(object->id % 2 == 0);
+        }
+
+        // The same statement serves lists of other lengths
+
+        const std::unordered_set<int> few = {1, 2, 3, constant::count + 1};
+        *db << SELECT << COUNT << FROM << constant::table << WHERE << &data::id << IN << bind_list(few);
+        const size_t count = *db;
+        assert(count == 3);
+
+        const std::vector<int> none;
+        *db << SELECT << COUNT << FROM << constant::table << WHERE << &data::id << IN << bind_list(none);
+        assert(size_t(*db) == 0);
+    }
+
+    // Strings, including ones to be escaped
+
+    {
+        const std::vector<std::string> texts = {"text 1", "text 5", "\"quoted\" \\ \n"};
+        *db << SELECT << ALL << FROM << constant::table << WHERE << &data::text << IN << bind_list(texts);
+        const std::vector<std::shared_ptr<data>> objects = *db;
+        assert(objects.size() == 2);
+
+        const auto object = std::make_shared<data>(data{0, 0, texts.back()});
+        *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+            << VALUES << '(' << constant::count + 1 << ',' << 0 << ',' << "'\"quoted\" \\ \n'" << ')' << ';';
+        *db << SELECT << ALL << FROM << constant::table << WHERE << &data::text << IN << bind_list(texts);
+        assert(std::vector<std::shared_ptr<data>>(*db).size() == 3);
+    }
+
+    // Batch deletes and the query cache
+
+    {
+        db->enable_query_cache();
+
+        const std::vector<int> ids = {1, 2, 3};
+        *db << SELECT << COUNT << FROM << constant::table << WHERE << &data::id << IN << bind_list(ids);
+        assert(size_t(*db) == 3);
+
+        *db << DELETE << FROM << constant::table << WHERE << &data::id << IN << bind_list(ids) << ';';
+
+        *db << SELECT << COUNT << FROM << constant::table << WHERE << &data::id << IN << bind_list(ids);
+        assert(size_t(*db) == 0);
+
+        const std::vector<int> others = {4, 5};
+        *db << SELECT << COUNT << FROM << constant::table << WHERE << &data::id << IN << bind_list(others);
+        assert(size_t(*db) == 2);
+
+        db->disable_query_cache();
+    }
+
+    // Integers are compared as integers, also with operands without affinity
+
+    {
+        const std::vector<int> numbers = {10, 20};
+        *db << SELECT << COUNT << FROM << constant::table << WHERE << "number + 0" << IN << bind_list(numbers);
+        assert(size_t(*db) == 2);
+    }
+
+    // Statements of queries with other literals are limited per connection
+
+    {
+        sqlite3 *connection = nullptr;
+        sqlite3_open_v2("test.db", &connection, SQLITE_OPEN_READWRITE, nullptr);
+
+        auto other = std::make_shared<sqlite::database<data>>(connection);
+        other->set_fields({{&data::id,     "id"},
+                           {&data::number, "number"},
+                           {&data::text,   "text"}});
+
+        const std::vector<int> ids = {10, 11};
+        for (int i = 0; i < int(statement_cache::capacity) + 50; ++i) {
+            *other << SELECT << COUNT << FROM << constant::table
+                   << WHERE << &data::number << '>' << i << AND << &data::id << IN << bind_list(ids);
+            assert(size_t(*other) == (i < 10 ? 2 : i == 10 ? 1 : 0));
+        }
+        assert(statement_cache::size(connection) == statement_cache::capacity);
+
+        other.reset();
+        statement_cache::release(connection);
+        assert(sqlite3_close(connection) == SQLITE_OK);
+    }
+
+    // Errors are reported
+
+    {
+        const std::vector<int> ids = {1};
+        *db << DELETE << FROM << "missing_table" << WHERE << &data::id << IN << bind_list(ids) << ';';
+        assert(!db->get_last_errors().empty());
+    }
+
+    return 0;
+}
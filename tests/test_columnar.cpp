@@ -0,0 +1,99 @@
+//
+//  test_columnar.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <numeric>
+#include <string>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int number;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *table = "test_columnar";
+        const int count = 1000;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db_with_data() {
+        auto db = sqlite::database<data>::open("test.db");
+        db->set_fields({{&data::id,     "id"},
+                        {&data::number, "number"},
+                        {&data::text,   "text"}});
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+        *db << DELETE << FROM << constant::table << ';';
+
+        *db << BEGIN_TRANSACTION << ';';
+        for (int i = 1; i <= constant::count; ++i) {
+            const auto object = std::make_shared<data>(data{0, i, i % 10 ? std::to_string(i) : ""});
+            *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << i << object << ')' << ';';
+        }
+        *db << COMMIT << ';';
+
+        return db;
+    }
+
+}
+
+int main() {
+    auto db = create_db_with_data();
+
+    // Numbers and strings
+
+    {
+        *db << FROM << constant::table << ORDER_BY << &data::id;
+        const auto [ids, numbers, texts] = db->select_columnar(&data::id, &data::number, &data::text);
+
+        assert(ids.size() == constant::count);
+        assert(numbers.size() == constant::count);
+        assert(texts.size() == constant::count);
+
+        assert(std::accumulate(numbers.begin(), numbers.end(), 0LL) ==
+               (long long) constant::count * (constant::count + 1) / 2);
+
+        for (size_t i = 0; i < texts.size(); ++i) {
+            assert(ids[i] == int(i) + 1);
+            assert(texts[i] == (ids[i] % 10 ? std::to_string(ids[i]) : ""));
+        }
+
+        assert(texts.offsets.back() == texts.buffer.size());
+    }
+
+    // Numbers are converted like those of objects
+
+    {
+        *db << UPDATE << constant::table << SET << &data::number << EQUALS << "1700000000000"
+            << WHERE << &data::id << EQUALS << 1 << ';';
+
+        *db << FROM << constant::table << WHERE << &data::id << EQUALS << 1;
+        const auto [numbers] = db->select_columnar(&data::number);
+        assert(numbers.front() == 1700000000);
+    }
+
+    // Empty results
+
+    {
+        *db << FROM << constant::table << WHERE << &data::id << EQUALS << -1;
+        const auto [numbers, texts] = db->select_columnar(&data::number, &data::text);
+        assert(numbers.empty());
+        assert(texts.size() == 0);
+    }
+
+    return 0;
+}
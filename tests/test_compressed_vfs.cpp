@@ -0,0 +1,112 @@
+//
+//  test_compressed_vfs.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <fstream>
+#include <string>
+
+#include <sqlite_orm/compressed_vfs.h>
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int number;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *db_name = "test_compressed_vfs.db";
+        const char *packed_db_name = "test_compressed_vfs.dbz";
+        const char *table = "test_compressed_vfs";
+        const size_t count = 5000;
+        const size_t chunk_size = 16 * 1024;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> set_fields(std::shared_ptr<sqlite::database<data>> db) {
+        db->set_fields({{&data::id,     "id"},
+                        {&data::number, "number"},
+                        {&data::text,   "text"}});
+        return db;
+    }
+
+    std::streamoff file_size(const char *path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        return file.tellg();
+    }
+
+}
+
+int main() {
+    std::remove(constant::db_name);
+    std::remove(constant::packed_db_name);
+
+    {
+        auto db = set_fields(sqlite::database<data>::open(constant::db_name));
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+        *db << BEGIN_TRANSACTION << ';';
+        for (size_t i = 0; i < constant::count; ++i) {
+            const auto object = std::make_shared<data>(data{0, int(i), "text_" + std::to_string(i % 100)});
+            *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << "null" << object << ')' << ';';
+        }
+        *db << COMMIT << ';';
+
+        assert(db->get_last_errors().empty());
+    }
+
+    sqlite::database<data>::clear_cache();
+
+    // Pack
+
+    assert(pack_database(constant::db_name, constant::packed_db_name, constant::chunk_size));
+    assert(file_size(constant::packed_db_name) < file_size(constant::db_name));
+
+    // Read
+
+    assert(register_compressed_vfs(compressed_vfs_name, nullptr, 4, 2) == SQLITE_OK);
+
+    {
+        auto db = set_fields(sqlite::database<data>::open_read_only(constant::packed_db_name, compressed_vfs_name));
+
+        *db << SELECT << ALL << FROM << constant::table << ORDER_BY << &data::id;
+
+        const std::vector<std::shared_ptr<data>> records = *db;
+        assert(records.size() == constant::count);
+        for (size_t i = 0; i < constant::count; ++i) {
+            assert(records[i]->number == int(i));
+            assert(records[i]->text == "text_" + std::to_string(i % 100));
+        }
+
+        *db << SELECT << COUNT << FROM << constant::table << WHERE << &data::number << EQUALS << 4321;
+        const int count = *db;
+        assert(count == 1);
+    }
+
+    sqlite::database<data>::clear_cache();
+
+    // Not packed
+
+    {
+        auto db = set_fields(sqlite::database<data>::open_read_only(constant::db_name, compressed_vfs_name));
+
+        *db << SELECT << COUNT << FROM << constant::table;
+        const int count = *db;
+        assert(count == 0);
+    }
+
+    sqlite::database<data>::clear_cache();
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+//
+//  test_container_table.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <string>
+#include <tuple>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int number;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *table = "test_container_table";
+        const char *container = "test_container_objects";
+        const int count = 10;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db_with_data() {
+        auto db = sqlite::database<data>::open("test.db");
+        db->set_fields({{&data::id,     "id"},
+                        {&data::number, "number"},
+                        {&data::text,   "text"}});
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+        *db << DELETE << FROM << constant::table << ';';
+
+        for (int i = 1; i <= constant::count; ++i) {
+            const auto object = std::make_shared<data>(data{0, i, "text " + std::to_string(i)});
+            *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << i << object << ')' << ';';
+        }
+
+        return db;
+    }
+
+    std::vector<std::shared_ptr<data>> create_objects(int count) {
+        std::vector<std::shared_ptr<data>> objects;
+        for (int i = 1; i <= count; ++i) {
+            objects.push_back(std::make_shared<data>(data{i * 2, i, "object " + std::to_string(i)}));
+        }
+        return objects;
+    }
+
+}
+
+int main() {
+    auto db = create_db_with_data();
+
+    const auto objects = create_objects(constant::count / 2);
+    db->set_unique_key(&data::text);
+    assert(db->expose(constant::container, objects));
+
+    // Scan
+
+    {
+        *db << SELECT << ALL << FROM << constant::container;
+        std::vector<std::shared_ptr<data>> result;
+        *db >> result;
+        assert(result.size() == objects.size());
+        assert(result[2]->id == 6);
+        assert(result[2]->text == "object 3");
+    }
+
+    // Lookups by key
+
+    {
+        *db << SELECT << &data::text << FROM << constant::container << WHERE << &data::id << EQUALS << 8;
+        const std::vector<std::string> texts = *db;
+        assert(texts.size() == 1 && texts.front() == "object 4");
+
+        *db << SELECT << &data::id << FROM << constant::container << WHERE << &data::text << EQUALS
+            << std::string("object 2");
+        assert(int(*db) == 4);
+
+        *db << SELECT << COUNT << FROM << constant::container << WHERE << &data::id << EQUALS << 3;
+        assert(int(*db) == 0);
+
+        *db << "EXPLAIN QUERY PLAN" << SELECT << ALL << FROM << constant::container
+            << WHERE << &data::id << EQUALS << 8;
+        std::vector<std::tuple<int, int, int, std::string>> plan;
+        *db >> plan;
+        assert(!plan.empty() && std::get<3>(plan.front()).find("INDEX 1:") != std::string::npos);
+    }
+
+    // Joins
+
+    {
+        *db << SELECT << "t.text" << FROM << constant::table << "t JOIN" << constant::container
+            << "c ON c.id = t.id" << ORDER_BY << "t.id";
+        const std::vector<std::string> texts = *db;
+        assert(texts.size() == objects.size());
+        assert(texts.front() == "text 2");
+        assert(texts.back() == "text 10");
+    }
+
+    // Arguments of other types and collations
+
+    {
+        const auto count = [&db](const char *column, const char *argument) {
+            *db << SELECT << COUNT << FROM << constant::container << WHERE << column << EQUALS << argument;
+            return int(*db);
+        };
+
+        assert(count("id", "'8'") == 1);
+        assert(count("id", "8.0") == 1);
+        assert(count("id", "8.5") == 0);
+        assert(count("id", "NULL") == 0);
+        assert(count("text", "'OBJECT 2'") == 0);
+        assert(count("text", "'OBJECT 2' COLLATE NOCASE") == 1);
+
+        const std::vector<std::shared_ptr<data>> zero = {std::make_shared<data>(data{0, 0, "zero"})};
+        assert(db->expose(constant::container, zero));
+        assert(count("id", "'abc'") == 0);
+        assert(count("id", "0") == 1);
+    }
+
+    // Exposing again, which only drops the statements using the container
+
+    {
+        const auto connection = db_cache::open_db("test.db", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr);
+        const auto table_query = std::string("SELECT number FROM ") + constant::table;
+        const auto container_query = std::string("SELECT number FROM ") + constant::container;
+        const auto kept = statement_cache::get(connection, table_query);
+        statement_cache::get(connection, container_query);
+        const auto size = statement_cache::size(connection);
+
+        const auto others = create_objects(constant::count);
+        assert(db->expose(constant::container, others));
+        assert(statement_cache::size(connection) < size);
+
+        auto statement = sqlite3_next_stmt(connection, nullptr);
+        while (statement && statement != kept) {
+            statement = sqlite3_next_stmt(connection, statement);
+        }
+        assert(statement == kept);
+
+        *db << SELECT << COUNT << FROM << constant::container;
+        assert(int(*db) == constant::count);
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+//
+//  test_data_version.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <atomic>
+#include <cassert>
+#include <string>
+#include <thread>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *db_name = "test_data_version.db";
+        const char *table = "test_data_version";
+
+    }
+
+    void insert(const std::shared_ptr<sqlite::database<data>> &db) {
+        const auto object = std::make_shared<data>(data{0, "text"});
+        *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+            << VALUES << '(' << "null" << object << ')' << ';';
+    }
+
+    // Stands for another process writing to the same file
+
+    void insert_externally() {
+        sqlite3 *db = nullptr;
+        sqlite3_open(constant::db_name, &db);
+        const auto query = std::string("INSERT INTO ") + constant::table + " (text) VALUES ('external')";
+        const auto status = sqlite3_exec(db, query.c_str(), nullptr, nullptr, nullptr);
+        assert(status == SQLITE_OK);
+        sqlite3_close(db);
+    }
+
+    template<class F>
+    bool wait_for(const F &predicate) {
+        for (size_t i = 0; i < 200 && !predicate(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return predicate();
+    }
+
+}
+
+int main() {
+    std::remove(constant::db_name);
+
+    auto db = sqlite::database<data>::open(constant::db_name);
+    db->set_fields({{&data::id,   "id"},
+                    {&data::text, "text"}});
+
+    *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+
+    // Tokens
+
+    {
+        auto token = db->get_data_version();
+        assert(!db->changed_since(token));
+
+        insert(db);
+        assert(db->changed_since(token));
+
+        token = db->get_data_version();
+        assert(!db->changed_since(token));
+
+        insert_externally();
+        assert(db->changed_since(token));
+
+        token = db->get_data_version();
+        assert(!db->changed_since(token));
+    }
+
+    // Watcher
+
+    {
+        std::atomic<int> changes(0);
+        const auto watcher = db->watch_data_version([&changes] {
+            ++changes;
+        }, std::chrono::milliseconds(10));
+        assert(watcher->is_watching());
+
+        insert_externally();
+        assert(wait_for([&changes] { return changes == 1; }));
+
+        insert(db);
+        assert(wait_for([&changes] { return changes == 2; }));
+
+        watcher->stop();
+        assert(!watcher->is_watching());
+
+        insert(db);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        assert(changes == 2);
+    }
+
+    return 0;
+}
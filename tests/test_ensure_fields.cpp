@@ -15,6 +15,7 @@ using namespace sqlite;
 namespace {
     const auto db_name = "test.db";
     const auto table = "test_ensure_fields";
+    const auto fingerprints_table = "_orm_fingerprints";
 }
 
 int main() {
@@ -67,5 +68,59 @@ int main() {
         assert(count == 2);
     }
 
+    // Fingerprint
+
+    {
+        *db << SELECT << COUNT << FROM << fingerprints_table << WHERE << "name" << EQUALS << std::string(table);
+        const int count = *db;
+        assert(count == 1);
+
+        db->ensure_fields(table);
+
+        const auto &errors = db->get_last_errors();
+        assert(errors.empty());
+    }
+
+    // Fingerprint mismatch
+
+    {
+        *db << UPDATE << fingerprints_table << SET << "fingerprint" << EQUALS << 0 << ';';
+
+        db->ensure_fields(table);
+
+        const auto &errors = db->get_last_errors();
+        assert(errors.empty());
+
+        *db << SELECT << COUNT << FROM << fingerprints_table << WHERE << "fingerprint" << EQUALS << 0;
+        const int count = *db;
+        assert(count == 0);
+    }
+
+    // Read-only database with a complete schema and no fingerprints
+
+    {
+        sqlite3 *connection = nullptr;
+        sqlite3_open(db_name, &connection);
+        sqlite3_exec(connection, "DROP TABLE _orm_fingerprints", nullptr, nullptr, nullptr);
+        sqlite3_close(connection);
+
+        sqlite::database<data>::clear_cache();
+
+        auto read_only_db = sqlite::database<data>::open_read_only(db_name);
+        read_only_db->set_fields({{&data::id,       "id"},
+                                  {&data::text,     "text"},
+                                  {&data::new_text, "new_text"}});
+
+        read_only_db->ensure_fields(table);
+        read_only_db->ensure_fields(table);
+
+        const auto &errors = read_only_db->get_last_errors();
+        assert(errors.empty());
+
+        *read_only_db << SELECT << COUNT << FROM << table;
+        const int count = *read_only_db;
+        assert(count == 2);
+    }
+
     return 0;
 }
\ No newline at end of file
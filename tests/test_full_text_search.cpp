@@ -0,0 +1,144 @@
+//
+//  test_full_text_search.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <string>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int number;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *table = "test_full_text_search";
+        const char *unique_index = "test_full_text_search_text";
+        const std::vector<std::string> texts = {"red apple", "green apple", "red car", "blue sky over the red sea"};
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db_with_data() {
+        auto db = sqlite::database<data>::open("test.db");
+        db->set_fields({{&data::id,     "id"},
+                        {&data::number, "number"},
+                        {&data::text,   "text"}});
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+        *db << DELETE << FROM << constant::table << ';';
+
+        for (int i = 1; i <= constant::texts.size(); ++i) {
+            const auto object = std::make_shared<data>(data{0, i, constant::texts[i - 1]});
+            *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << i << object << ')' << ';';
+        }
+
+        return db;
+    }
+
+}
+
+int main() {
+    auto db = create_db_with_data();
+
+    // Existing rows are indexed
+
+    {
+        assert(db->enable_full_text_search(constant::table, &data::text));
+        assert(db->enable_full_text_search(constant::table, &data::text));
+
+        const auto apples = db->search(constant::table, "apple");
+        assert(apples.size() == 2);
+
+        const auto red = db->search(constant::table, "red", 2);
+        assert(red.size() == 2);
+        assert(red.front()->text == "red apple" || red.front()->text == "red car");
+
+        assert(db->search(constant::table, "red AND apple").front()->id == 1);
+        assert(db->search(constant::table, "violet").empty());
+    }
+
+    // Triggers keep the index in sync
+
+    {
+        const auto object = std::make_shared<data>(data{0, 5, "violet apple"});
+        *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+            << VALUES << '(' << 5 << object << ')' << ';';
+        assert(db->search(constant::table, "violet").size() == 1);
+
+        const auto replaced = std::make_shared<data>(data{0, 1, "yellow banana"});
+        *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+            << VALUES << '(' << 1 << replaced << ')' << ';';
+        assert(db->search(constant::table, "apple").size() == 2);
+        assert(db->search(constant::table, "banana").front()->number == 1);
+
+        *db << UPDATE << constant::table << SET << &data::text << EQUALS << std::string("orange car")
+            << WHERE << &data::id << EQUALS << 2 << ';';
+        assert(db->search(constant::table, "car").size() == 2);
+
+        *db << DELETE << FROM << constant::table << WHERE << &data::id << EQUALS << 3 << ';';
+        assert(db->search(constant::table, "car").size() == 1);
+        assert(db->get_last_errors().empty());
+    }
+
+    // Writes of other connections, which don't enable anything
+
+    {
+        sqlite3 *other = nullptr;
+        sqlite3_open_v2("test.db", &other, SQLITE_OPEN_READWRITE, nullptr);
+
+        const auto query = std::string("INSERT OR REPLACE INTO ") + constant::table +
+                           " (id,number,text) VALUES (5,5,'purple grape')";
+        assert(sqlite3_exec(other, query.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK);
+
+        const auto search_table = db->get_search_table(constant::table);
+        const auto check = "INSERT INTO " + search_table + '(' + search_table + ") VALUES ('integrity-check')";
+        assert(sqlite3_exec(other, check.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK);
+        sqlite3_close(other);
+
+        assert(db->search(constant::table, "violet").empty());
+        assert(db->search(constant::table, "grape").front()->id == 5);
+    }
+
+    // Conflicts left alone
+
+    {
+        *db << CREATE_UNIQUE_INDEX_IF_NOT_EXISTS << constant::unique_index << ON << constant::table
+            << '(' << &data::text << ')' << ';';
+        db->set_unique_key(&data::text);
+        const auto object = std::make_shared<data>(data{0, 6, "purple grape"});
+        assert(db->upsert(constant::table, {object}));
+        assert(db->search(constant::table, "grape").size() == 1);
+        assert(db->search(constant::table, "grape").front()->number == 6);
+    }
+
+    // Commands
+
+    {
+        const auto search_table = db->get_search_table(constant::table);
+
+        *db << SELECT << SNIPPET << '(' << search_table.c_str() << ", 0, '[', ']', '...', 3)" << FROM
+            << search_table.c_str() << WHERE << search_table.c_str() << MATCH << std::string("sea");
+        const std::vector<std::string> snippets = *db;
+        assert(snippets.size() == 1);
+        assert(snippets.front() == "...the red [sea]");
+
+        *db << SELECT << "rowid" << FROM << search_table.c_str() << WHERE << search_table.c_str() << MATCH
+            << std::string("red") << ORDER_BY << BM25 << '(' << search_table.c_str() << ')';
+        const std::vector<int> ids = *db;
+        assert(ids.size() == 1 && ids.front() == 4);
+    }
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+//
+//  test_functions.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int number;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *table = "test_functions";
+        const char *index = "test_functions_reversed";
+        const int count = 10;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db_with_data() {
+        auto db = sqlite::database<data>::open("test.db");
+        db->set_fields({{&data::id,     "id"},
+                        {&data::number, "number"},
+                        {&data::text,   "text"}});
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+        *db << DELETE << FROM << constant::table << ';';
+
+        for (int i = 1; i <= constant::count; ++i) {
+            const auto object = std::make_shared<data>(data{0, i, "text " + std::to_string(i)});
+            *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << i << object << ')' << ';';
+        }
+
+        return db;
+    }
+
+    int squared(int value) {
+        return value * value;
+    }
+
+    struct sum_of_squares {
+        int64_t sum = 0;
+    };
+
+}
+
+int main() {
+    auto db = create_db_with_data();
+
+    // Scalars
+
+    {
+        assert(db->register_function("is_even", [](int value) {
+            return value % 2 == 0;
+        }));
+        assert(db->register_function("reversed", [](const std::string &text) {
+            return std::string(text.rbegin(), text.rend());
+        }));
+        assert(db->register_function("scaled", [](double value, double factor) {
+            return value * factor;
+        }));
+
+        *db << SELECT << COUNT << FROM << constant::table << WHERE << "is_even(" << &data::number << ')';
+        assert(int(*db) == constant::count / 2);
+
+        *db << FROM << constant::table << WHERE << &data::id << EQUALS << 1;
+        const auto rows = db->select(&data::text);
+        assert(std::get<0>(rows.front()) == "text 1");
+
+        *db << SELECT << "reversed(" << &data::text << ')' << FROM << constant::table
+            << WHERE << &data::id << EQUALS << 1;
+        const std::vector<std::string> reversed = *db;
+        assert(reversed.front() == "1 txet");
+
+        *db << SELECT << "scaled(" << &data::number << ", 0.5)" << FROM << constant::table
+            << WHERE << &data::id << EQUALS << 3;
+        assert(double(*db) == 1.5);
+
+        // Plain functions
+
+        assert(db->register_function("squared", &squared));
+        *db << SELECT << "squared(" << &data::number << ')' << FROM << constant::table
+            << WHERE << &data::id << EQUALS << 3;
+        assert(int(*db) == 9);
+
+        // Deterministic functions can be indexed
+
+        *db << CREATE_INDEX_IF_NOT_EXISTS << constant::index << ON << constant::table
+            << '(' << "reversed(" << &data::text << ')' << ')' << ';';
+        assert(db->get_last_errors().empty());
+    }
+
+    // Errors
+
+    {
+        assert(db->register_function("failing", [](int) -> int {
+            throw std::runtime_error("failed");
+        }));
+
+        *db << SELECT << "failing(" << &data::number << ')' << FROM << constant::table;
+        const std::vector<int> values = *db;
+        assert(values.empty());
+    }
+
+    // Aggregates
+
+    {
+        assert(db->register_aggregate<sum_of_squares>("sum_of_squares", [](sum_of_squares &state, int value) {
+            state.sum += value * value;
+        }, [](const sum_of_squares &state) {
+            return state.sum;
+        }));
+
+        *db << SELECT << "sum_of_squares(" << &data::number << ')' << FROM << constant::table;
+        assert(int64_t(*db) == 385);
+
+        *db << SELECT << "sum_of_squares(" << &data::number << ')' << FROM << constant::table
+            << WHERE << &data::id << EQUALS << -1;
+        assert(int64_t(*db) == 0);
+    }
+
+    // Window functions
+
+    {
+        assert(db->register_window<sum_of_squares>("moving_sum_of_squares", [](sum_of_squares &state, int value) {
+            state.sum += value * value;
+        }, [](sum_of_squares &state, int value) {
+            state.sum -= value * value;
+        }, [](const sum_of_squares &state) {
+            return state.sum;
+        }));
+
+        *db << SELECT << "moving_sum_of_squares(" << &data::number << ") OVER (ORDER BY " << &data::id
+            << "ROWS BETWEEN 1 PRECEDING AND CURRENT ROW)" << FROM << constant::table;
+        const std::vector<int> sums = *db;
+        assert(sums.size() == constant::count);
+        assert(sums[0] == 1);
+        assert(sums[1] == 1 + 4);
+        assert(sums[9] == 81 + 100);
+    }
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+//
+//  test_identity_map.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <string>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int number;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *table = "test_identity_map";
+        const char *unique_table = "test_identity_map_unique";
+        const char *unique_index = "test_identity_map_unique_number";
+        const size_t count = 3;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db_with_data() {
+        auto db = sqlite::database<data>::open("test.db");
+        db->set_fields({{&data::id,     "id"},
+                        {&data::number, "number"},
+                        {&data::text,   "text"}});
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+        *db << DELETE << FROM << constant::table << ';';
+
+        for (size_t i = 1; i <= constant::count; ++i) {
+            const auto object = std::make_shared<data>(data{0, int(i), "text"});
+            *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << int(i) << object << ')' << ';';
+        }
+
+        return db;
+    }
+
+}
+
+int main() {
+
+    // Repeated reads
+
+    {
+        auto db = create_db_with_data();
+        db->enable_identity_map(constant::table);
+
+        const auto object = db->find_by_id(constant::table, 1);
+        assert(object && object->number == 1);
+        assert(db->find_by_id(constant::table, 1) == object);
+
+        assert(!db->find_by_id(constant::table, 100));
+    }
+
+    // Update
+
+    {
+        auto db = create_db_with_data();
+        db->enable_identity_map(constant::table);
+
+        const auto object = db->find_by_id(constant::table, 1);
+
+        *db << UPDATE << constant::table << SET << &data::number << EQUALS << 10
+            << WHERE << &data::id << EQUALS << 1 << ';';
+
+        const auto updated = db->find_by_id(constant::table, 1);
+        assert(updated != object);
+        assert(updated->number == 10);
+
+        // Other rows stay cached
+
+        const auto other = db->find_by_id(constant::table, 2);
+        *db << UPDATE << constant::table << SET << &data::number << EQUALS << 10
+            << WHERE << &data::id << EQUALS << 1 << ';';
+        assert(db->find_by_id(constant::table, 2) == other);
+    }
+
+    // Replace
+
+    {
+        auto db = create_db_with_data();
+        db->enable_identity_map(constant::table);
+
+        const auto object = db->find_by_id(constant::table, 1);
+
+        const auto replacement = std::make_shared<data>(data{0, 20, "text"});
+        *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+            << VALUES << '(' << 1 << replacement << ')' << ';';
+
+        assert(db->find_by_id(constant::table, 1)->number == 20);
+    }
+
+    // Replace on a unique key other than the id
+
+    {
+        auto db = create_db_with_data();
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::unique_table << '(' << ALL << ')' << ';';
+        *db << CREATE_UNIQUE_INDEX_IF_NOT_EXISTS << constant::unique_index << ON << constant::unique_table
+            << '(' << &data::number << ')' << ';';
+        *db << DELETE << FROM << constant::unique_table << ';';
+        *db << INSERT_INTO << constant::unique_table << SELECT << ALL << FROM << constant::table << ';';
+        db->enable_identity_map(constant::unique_table);
+
+        assert(db->find_by_id(constant::unique_table, 1));
+        const auto replacement = std::make_shared<data>(data{0, 1, "text"});
+        *db << INSERT_OR_REPLACE_INTO << constant::unique_table << '(' << ALL << ')'
+            << VALUES << '(' << 10 << replacement << ')' << ';';
+        assert(!db->find_by_id(constant::unique_table, 1));
+        assert(db->find_by_id(constant::unique_table, 10)->number == 1);
+    }
+
+    // Rollback
+
+    {
+        auto db = create_db_with_data();
+        db->enable_identity_map(constant::table);
+
+        *db << BEGIN_TRANSACTION << ';';
+        *db << UPDATE << constant::table << SET << &data::number << EQUALS << 10
+            << WHERE << &data::id << EQUALS << 1 << ';';
+        assert(db->find_by_id(constant::table, 1)->number == 10);
+        *db << ROLLBACK << ';';
+
+        assert(db->find_by_id(constant::table, 1)->number == 1);
+    }
+
+    // Delete, including DELETE without WHERE
+
+    {
+        auto db = create_db_with_data();
+        db->enable_identity_map(constant::table);
+
+        assert(db->find_by_id(constant::table, 1));
+        *db << DELETE << FROM << constant::table << WHERE << &data::id << EQUALS << 1 << ';';
+        assert(!db->find_by_id(constant::table, 1));
+
+        assert(db->find_by_id(constant::table, 2));
+        *db << DELETE << FROM << constant::table << ';';
+        assert(!db->find_by_id(constant::table, 2));
+    }
+
+    // Capacity
+
+    {
+        auto db = create_db_with_data();
+        db->enable_identity_map(constant::table, 1);
+
+        const auto object_1 = db->find_by_id(constant::table, 1);
+        const auto object_2 = db->find_by_id(constant::table, 2);
+        assert(db->find_by_id(constant::table, 2) == object_2);
+        assert(db->find_by_id(constant::table, 1) != object_1);
+    }
+
+    // Weak references
+
+    {
+        auto db = create_db_with_data();
+        db->enable_identity_map(constant::table, 1024, true);
+
+        auto object = db->find_by_id(constant::table, 1);
+        assert(db->find_by_id(constant::table, 1) == object);
+
+        const auto number = object->number;
+        object.reset();
+        assert(db->find_by_id(constant::table, 1)->number == number);
+    }
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+//
+//  test_join.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <string>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int number;
+        std::string text;
+    };
+
+    struct item {
+        int id;
+        int data_id;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *table = "test_join";
+        const char *items_table = "test_join_items";
+        const int count = 10;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db_with_data() {
+        auto db = sqlite::database<data>::open("test.db");
+        db->set_fields({{&data::id,     "id"},
+                        {&data::number, "number"},
+                        {&data::text,   "text"}});
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+        *db << DELETE << FROM << constant::table << ';';
+
+        for (int i = 1; i <= constant::count; ++i) {
+            const auto object = std::make_shared<data>(data{0, i, "text " + std::to_string(i)});
+            *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << i << object << ')' << ';';
+        }
+
+        return db;
+    }
+
+    // Data with an odd id has as many items as its id, the others have none
+
+    std::shared_ptr<sqlite::database<item>> create_items_db_with_data() {
+        auto db = sqlite::database<item>::open("test.db");
+        db->set_fields({{&item::id,      "id"},
+                        {&item::data_id, "data_id"},
+                        {&item::text,    "text"}});
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::items_table << '(' << ALL << ')' << ';';
+        *db << DELETE << FROM << constant::items_table << ';';
+
+        int id = 1;
+        for (int i = 1; i <= constant::count; i += 2) {
+            for (int j = 0; j < i; ++j) {
+                const auto object = std::make_shared<item>(item{0, i, "item " + std::to_string(j)});
+                *db << INSERT_OR_REPLACE_INTO << constant::items_table << '(' << ALL << ')'
+                    << VALUES << '(' << id++ << object << ')' << ';';
+            }
+        }
+
+        return db;
+    }
+
+}
+
+int main() {
+    auto db = create_db_with_data();
+    auto items_db = create_items_db_with_data();
+
+    // Pairs
+
+    {
+        const auto rows = db->join(*items_db, constant::table, &data::id, constant::items_table, &item::data_id);
+        assert(rows.size() == 1 + 3 + 5 + 7 + 9);
+        for (const auto &[object, item]: rows) {
+            assert(object.id == item.data_id);
+            assert(object.text == "text " + std::to_string(object.id));
+        }
+
+        *db << WHERE << "a.number" << EQUALS << 3 << ORDER_BY << "b.id" << DESC;
+        const auto filtered = db->join(*items_db, constant::table, &data::id, constant::items_table,
+                                       &item::data_id);
+        assert(filtered.size() == 3);
+        assert(filtered.front().second.text == "item 2");
+        assert(filtered.back().second.text == "item 0");
+    }
+
+    // Groups
+
+    {
+        *db << ORDER_BY << "a.id";
+        const auto groups = db->join_grouped(*items_db, constant::table, &data::id, constant::items_table,
+                                             &item::data_id);
+        assert(groups.size() == constant::count);
+        for (const auto &[object, items]: groups) {
+            assert(items.size() == (object.id % 2 == 0 ? 0 : object.id));
+            for (const auto &item: items) {
+                assert(item.data_id == object.id);
+            }
+        }
+        assert(groups[4].first.number == 5);
+    }
+
+    return 0;
+}
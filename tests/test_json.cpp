@@ -0,0 +1,196 @@
+//
+//  test_json.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <string>
+#include <tuple>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int number;
+        std::string payload;
+    };
+
+    namespace constant {
+
+        const char *table = "test_json";
+        const char *altered_table = "test_json_altered";
+        const char *index = "test_json_kind";
+        const int count = 10;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db() {
+        auto db = sqlite::database<data>::open("test.db");
+        db->set_fields({{&data::id,      "id"},
+                        {&data::number,  "number"},
+                        {&data::payload, "payload", column<data>::type::JSON}});
+        return db;
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db_with_data() {
+        auto db = create_db();
+        db->set_json_path("kind", &data::payload, "$.kind");
+        db->set_json_path("size", &data::payload, "$.size", true);
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+        *db << DELETE << FROM << constant::table << ';';
+
+        for (int i = 1; i <= constant::count; ++i) {
+            const auto kind = i % 2 == 0 ? "even" : "odd";
+            const auto payload = R"({"kind":")" + std::string(kind) + R"(","size":)" + std::to_string(i) + "}";
+            const auto object = std::make_shared<data>(data{0, i, payload});
+            *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << i << object << ')' << ';';
+        }
+
+        return db;
+    }
+
+}
+
+int main() {
+    auto db = create_db_with_data();
+
+    // Documents
+
+    {
+        *db << SELECT << ALL << FROM << constant::table << WHERE << &data::id << EQUALS << 3;
+        std::vector<std::shared_ptr<data>> objects;
+        *db >> objects;
+        assert(objects.front()->payload == R"({"kind":"odd","size":3})");
+
+        const auto empty = std::make_shared<data>(data{0, 0, ""});
+        *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+            << VALUES << '(' << 100 << empty << ')' << ';';
+        assert(db->get_last_errors().empty());
+
+        *db << SELECT << COUNT << FROM << constant::table << WHERE << &data::payload << "IS NULL";
+        assert(int(*db) == 1);
+
+        const auto invalid = std::make_shared<data>(data{0, 0, "{kind"});
+        *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+            << VALUES << '(' << 101 << invalid << ')' << ';';
+        assert(!db->get_last_errors().empty());
+
+        *db << DELETE << FROM << constant::table << WHERE << &data::id << EQUALS << 100 << ';';
+
+        // Stored as JSONB where the library has it, and read back as text
+
+        *db << SELECT << "typeof(payload)" << FROM << constant::table << WHERE << &data::id << EQUALS << 3;
+        const std::vector<std::string> types = *db;
+        assert(types.front() == (sqlite3_libversion_number() >= 3045000 ? "blob" : "text"));
+
+        const auto changed = std::make_shared<data>(data{3, 3, R"({"kind":"odd","size":30})"});
+        assert(db->upsert(constant::table, {changed}));
+        *db << SELECT << json_extract(&data::payload, "$.size") << FROM << constant::table
+            << WHERE << &data::id << EQUALS << 3;
+        assert(int(*db) == 30);
+
+        auto tracked = db->track(std::make_shared<data>(*changed));
+        tracked->payload = R"({"kind":"odd","size":3})";
+        assert(db->save(constant::table, tracked));
+
+        *db << SELECT << ALL << FROM << constant::table << WHERE << &data::id << EQUALS << 3;
+        objects.clear();
+        *db >> objects;
+        assert(objects.front()->payload == R"({"kind":"odd","size":3})");
+    }
+
+    // Paths
+
+    {
+        *db << SELECT << COUNT << FROM << constant::table
+            << WHERE << json_extract(&data::payload, "$.kind") << EQUALS << std::string("even");
+        assert(int(*db) == constant::count / 2);
+
+        *db << SELECT << &data::id << FROM << constant::table
+            << WHERE << json_extract(&data::payload, "$.size") << ">" << 8;
+        const std::vector<int> ids = *db;
+        assert(ids.size() == 2);
+
+        *db << SELECT << json_extract(&data::payload, "$.kind") << FROM << constant::table
+            << WHERE << &data::id << EQUALS << 1;
+        const std::vector<std::string> kinds = *db;
+        assert(kinds.front() == "odd");
+
+        *db << SELECT << COUNT << FROM << constant::table
+            << WHERE << json_extract(&data::payload, "$.missing") << "IS NULL";
+        assert(int(*db) == constant::count);
+
+        *db << SELECT << COUNT << FROM << constant::table
+            << WHERE << json_extract(&data::payload, R"($."it's")") << "IS NULL";
+        assert(int(*db) == constant::count);
+    }
+
+    // Indexes on paths
+
+    {
+        *db << CREATE_INDEX_IF_NOT_EXISTS << constant::index << ON << constant::table
+            << '(' << json_extract(&data::payload, "$.kind") << ')' << ';';
+
+        *db << "EXPLAIN QUERY PLAN" << SELECT << &data::id << FROM << constant::table
+            << WHERE << json_extract(&data::payload, "$.kind") << EQUALS << std::string("odd");
+        std::vector<std::tuple<int, int, int, std::string>> plan;
+        *db >> plan;
+        assert(!plan.empty() && std::get<3>(plan.front()).find(constant::index) != std::string::npos);
+    }
+
+    // Paths added to existing tables
+
+    {
+        sqlite3 *connection = nullptr;
+        sqlite3_open_v2("test.db", &connection, SQLITE_OPEN_READWRITE, nullptr);
+        const auto query = std::string("DROP TABLE IF EXISTS ") + constant::altered_table + ";" +
+                           "CREATE TABLE " + constant::altered_table + " (id integer primary key, payload text);" +
+                           "INSERT INTO " + constant::altered_table + " VALUES (1, '{\"kind\":\"old\"}');" +
+                           "DELETE FROM _orm_fingerprints WHERE name='" + constant::altered_table + "'";
+        sqlite3_exec(connection, query.c_str(), nullptr, nullptr, nullptr);
+        sqlite3_close(connection);
+
+        auto other = create_db();
+        other->set_json_path("kind", &data::payload, "$.kind");
+        other->set_json_path("size", &data::payload, "$.size", true);
+        other->ensure_fields(constant::altered_table);
+
+        // Stored paths are skipped, without keeping the other columns from being added
+
+        assert(other->get_last_errors().size() == 1);
+        assert(other->get_last_errors().front().find("size") != std::string::npos);
+
+        const auto object = std::make_shared<data>(data{0, 7, R"({"kind":"new"})"});
+        *other << INSERT_OR_REPLACE_INTO << constant::altered_table << '(' << ALL << ')'
+               << VALUES << '(' << 2 << object << ')' << ';';
+
+        *other << SELECT << "kind" << FROM << constant::altered_table << ORDER_BY << &data::id;
+        const std::vector<std::string> kinds = *other;
+        assert(kinds.size() == 2 && kinds.front() == "old" && kinds.back() == "new");
+
+        *other << SELECT << &data::number << FROM << constant::altered_table << WHERE << &data::id << EQUALS << 2;
+        assert(int(*other) == 7);
+
+        // The missing stored path is read from the document, and the fingerprint isn't stored
+
+        *other << SELECT << COUNT << FROM << constant::altered_table
+               << WHERE << json_extract(&data::payload, "$.size") << "IS NULL";
+        assert(int(*other) == 2);
+        assert(other->get_last_errors().size() == 1);
+
+        *other << SELECT << COUNT << FROM << "_orm_fingerprints" << WHERE << "name" << EQUALS
+               << std::string(constant::altered_table);
+        assert(int(*other) == 0);
+    }
+
+    return 0;
+}
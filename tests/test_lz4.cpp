@@ -0,0 +1,123 @@
+//
+//  test_lz4.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "lz4.h"
+
+using namespace sqlite;
+
+namespace {
+
+    std::vector<uint8_t> to_bytes(const std::string &text) {
+        return {text.begin(), text.end()};
+    }
+
+    std::vector<uint8_t> compress(const std::vector<uint8_t> &input) {
+        std::vector<uint8_t> output(lz4_compress_bound(input.size()));
+        const auto size = lz4_compress(input.data(), input.size(), output.data(), output.size());
+        assert(size > 0);
+        output.resize(size);
+        return output;
+    }
+
+    std::vector<uint8_t> decompress(const std::vector<uint8_t> &input, size_t capacity) {
+        std::vector<uint8_t> output(capacity);
+        const auto size = lz4_decompress(input.data(), input.size(), output.data(), output.size());
+        assert(size >= 0);
+        output.resize(size_t(size));
+        return output;
+    }
+
+    void assert_round_trip(const std::vector<uint8_t> &input) {
+        assert(decompress(compress(input), input.size()) == input);
+    }
+
+}
+
+int main() {
+
+    // Round trips
+
+    {
+        assert_round_trip({});
+        assert_round_trip(to_bytes("a"));
+        assert_round_trip(to_bytes("short text"));
+        assert_round_trip(to_bytes(std::string(100000, 'a')));
+
+        std::string text;
+        for (int i = 0; i < 1000; ++i) {
+            text += "row " + std::to_string(i % 37) + " of the table;";
+        }
+        const auto repetitive = to_bytes(text);
+        assert_round_trip(repetitive);
+        assert(compress(repetitive).size() < repetitive.size() / 4);
+
+        std::mt19937 random(42);
+        std::vector<uint8_t> noise(70000);
+        for (auto &byte: noise) {
+            byte = uint8_t(random());
+        }
+        assert_round_trip(noise);
+
+        // Literal runs and matches longer than 15 + 255, and matches beyond the maximum offset
+
+        std::vector<uint8_t> mixed(noise.begin(), noise.begin() + 600);
+        mixed.insert(mixed.end(), 600, 'b');
+        mixed.insert(mixed.end(), noise.begin(), noise.begin() + 600);
+        mixed.insert(mixed.end(), noise.begin(), noise.end());
+        mixed.insert(mixed.end(), noise.begin(), noise.begin() + 100);
+        assert_round_trip(mixed);
+    }
+
+    // Blocks of the reference implementation
+
+    {
+        const std::vector<uint8_t> sentences = {
+                0xff, 0x1e, 0x54, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20, 0x62, 0x72,
+                0x6f, 0x77, 0x6e, 0x20, 0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20,
+                0x6f, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x61, 0x7a, 0x79, 0x20,
+                0x64, 0x6f, 0x67, 0x2e, 0x20, 0x2d, 0x00, 0x6f, 0x50, 0x64, 0x6f, 0x67, 0x2e, 0x20};
+
+        std::string expected;
+        for (int i = 0; i < 4; ++i) {
+            expected += "The quick brown fox jumps over the lazy dog. ";
+        }
+        assert(decompress(sentences, expected.size()) == to_bytes(expected));
+
+        const std::vector<uint8_t> run = {
+                0x1f, 0x61, 0x01, 0x00, 0xff, 0x19, 0xf0, 0x00, 0x20, 0x65, 0x6e, 0x64, 0x20, 0x6f,
+                0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x72, 0x75, 0x6e};
+        assert(decompress(run, 315) == to_bytes(std::string(300, 'a') + " end of the run"));
+    }
+
+    // Output that doesn't fit and malformed input
+
+    {
+        const auto input = to_bytes(std::string(1000, 'c') + "tail of the input");
+        const auto compressed = compress(input);
+
+        std::vector<uint8_t> output(compressed.size() - 1);
+        assert(lz4_compress(input.data(), input.size(), output.data(), output.size()) == 0);
+
+        output.resize(input.size() - 1);
+        assert(lz4_decompress(compressed.data(), compressed.size(), output.data(), output.size()) == -1);
+
+        output.resize(input.size());
+        assert(lz4_decompress(compressed.data(), compressed.size() - 1, output.data(), output.size()) == -1);
+
+        const std::vector<uint8_t> bad_offset = {0x10, 0x61, 0x05, 0x00};
+        assert(lz4_decompress(bad_offset.data(), bad_offset.size(), output.data(), output.size()) == -1);
+    }
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+//
+//  test_mmap_vfs.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <string>
+
+#include <sqlite_orm/database.h>
+#include <sqlite_orm/mmap_vfs.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *db_name = "test_mmap_vfs.db";
+        const char *table = "test_mmap_vfs";
+        const size_t count = 100;
+
+    }
+
+}
+
+int main() {
+    std::remove(constant::db_name);
+
+    // Write
+
+    {
+        auto db = sqlite::database<data>::open(constant::db_name);
+        db->set_fields({{&data::id,   "id"},
+                        {&data::text, "text"}});
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+
+        *db << BEGIN_TRANSACTION << ';';
+        for (size_t i = 0; i < constant::count; ++i) {
+            const auto object = std::make_shared<data>(data{0, std::string(1000, 'a' + i % 26)});
+            *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << "null" << object << ')' << ';';
+        }
+        *db << COMMIT << ';';
+
+        assert(db->get_last_errors().empty());
+    }
+
+    sqlite::database<data>::clear_cache();
+
+    // Read
+
+    const auto result = register_mmap_vfs();
+    assert(result == SQLITE_OK);
+
+    {
+        auto db = sqlite::database<data>::open_read_only(constant::db_name, mmap_vfs_name);
+        db->set_fields({{&data::id,   "id"},
+                        {&data::text, "text"}});
+
+        *db << PRAGMA << "mmap_size = 268435456";
+        const int mmap_size = *db;
+        assert(mmap_size > 0);
+
+        *db << SELECT << ALL << FROM << constant::table << ORDER_BY << &data::id;
+
+        const std::vector<std::shared_ptr<data>> records = *db;
+        assert(records.size() == constant::count);
+        assert(records.back()->text == std::string(1000, 'a' + (constant::count - 1) % 26));
+
+        // Read-only
+
+        const auto object = std::make_shared<data>(data{0, "text"});
+        *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+            << VALUES << '(' << "null" << object << ')' << ';';
+        assert(!db->get_last_errors().empty());
+    }
+
+    sqlite::database<data>::clear_cache();
+
+    return 0;
+}
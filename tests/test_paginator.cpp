@@ -0,0 +1,162 @@
+//
+//  test_paginator.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int number;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *table = "test_paginator";
+        const char *timestamps_table = "test_paginator_timestamps";
+        const int count = 25;
+        const int page_size = 4;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db_with_data() {
+        auto db = sqlite::database<data>::open("test.db");
+        db->set_fields({{&data::id,     "id"},
+                        {&data::number, "number"},
+                        {&data::text,   "text"}});
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+        *db << DELETE << FROM << constant::table << ';';
+
+        *db << BEGIN_TRANSACTION << ';';
+        for (int i = 1; i <= constant::count; ++i) {
+            const auto object = std::make_shared<data>(data{0, i % 5, "text " + std::to_string(constant::count - i)});
+            *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << i << object << ')' << ';';
+        }
+        *db << COMMIT << ';';
+
+        return db;
+    }
+
+}
+
+int main() {
+    auto db = create_db_with_data();
+
+    // Pages in key order, with the id breaking ties
+
+    {
+        *db << SELECT << ALL << FROM << constant::table;
+        const auto paginator = db->paginate(constant::page_size, &data::number);
+
+        std::vector<std::shared_ptr<data>> objects;
+        size_t pages = 0;
+        for (auto page = paginator->next(); !page.empty(); page = paginator->next()) {
+            assert(page.size() <= constant::page_size);
+            objects.insert(objects.end(), page.begin(), page.end());
+            ++pages;
+        }
+
+        assert(pages == (constant::count + constant::page_size - 1) / constant::page_size);
+        assert(objects.size() == constant::count);
+        assert(paginator->is_done());
+
+        for (size_t i = 1; i < objects.size(); ++i) {
+            const auto &a = *objects[i - 1];
+            const auto &b = *objects[i];
+            assert(a.number < b.number || (a.number == b.number && a.id < b.id));
+        }
+
+        // Rewind
+
+        paginator->rewind();
+        const auto first = paginator->next();
+        assert(first.front()->id == objects.front()->id);
+    }
+
+    // Filtered query, string keys and visitor
+
+    {
+        *db << SELECT << ALL << FROM << constant::table << WHERE << &data::number << EQUALS << 1;
+        const auto paginator = db->paginate(constant::page_size, &data::text);
+
+        std::vector<std::string> texts;
+        while (paginator->next([&texts](const std::shared_ptr<data> &object) {
+            assert(object->number == 1);
+            texts.push_back(object->text);
+        })) {
+        }
+
+        assert(texts.size() == constant::count / 5);
+        assert(std::is_sorted(texts.begin(), texts.end()));
+    }
+
+    // Keys beyond 32 bits are rebound from the raw column values, and a short page is the last
+
+    {
+        auto timestamps = sqlite::database<data>::open("test.db");
+        timestamps->set_fields({{&data::id,     "id"},
+                                {&data::number, "ts"}});
+
+        *timestamps << CREATE_TABLE_IF_NOT_EXISTS << constant::timestamps_table << '(' << ALL << ')' << ';';
+        *timestamps << DELETE << FROM << constant::timestamps_table << ';';
+        for (int i = 1; i <= 10; ++i) {
+            *timestamps << INSERT_INTO << constant::timestamps_table << VALUES << '(' << i << ','
+                        << std::to_string(1700000000000LL + i * 100).c_str() << ')' << ';';
+        }
+
+        *timestamps << SELECT << ALL << FROM << constant::timestamps_table;
+        const auto paginator = timestamps->paginate(3, &data::number);
+
+        std::vector<int> ids;
+        size_t pages = 0;
+        while (paginator->next([&ids](const std::shared_ptr<data> &object) {
+            ids.push_back(object->id);
+        })) {
+            ++pages;
+        }
+
+        assert(ids == (std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+        assert(pages == 4);
+        assert(paginator->is_done());
+    }
+
+    // Paginator outliving the database object, with its statements finalized with the connection's
+
+    {
+        sqlite3 *connection = nullptr;
+        sqlite3_open_v2("test.db", &connection, SQLITE_OPEN_READWRITE, nullptr);
+
+        auto other = std::make_shared<sqlite::database<data>>(connection);
+        other->set_fields({{&data::id,     "id"},
+                           {&data::number, "number"},
+                           {&data::text,   "text"}});
+
+        *other << SELECT << ALL << FROM << constant::table;
+        const auto paginator = other->paginate(constant::page_size, &data::number);
+        assert(paginator->next().size() == constant::page_size);
+
+        other.reset();
+        const auto page = paginator->next();
+        assert(page.size() == constant::page_size);
+        assert(page.front()->text == "text " + std::to_string(constant::count - page.front()->id));
+
+        statement_cache::release(connection);
+        assert(sqlite3_close(connection) == SQLITE_OK);
+    }
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+//
+//  test_parallel_scan.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <string>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int number;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *db_name = "test_parallel_scan.db";
+        const char *table = "test_parallel_scan";
+        const int count = 1000;
+        const size_t partitions = 4;
+
+    }
+
+    void set_fields(const std::shared_ptr<sqlite::database<data>> &db) {
+        db->set_fields({{&data::id,     "id"},
+                        {&data::number, "number"},
+                        {&data::text,   "text"}});
+    }
+
+    void check(const std::vector<std::shared_ptr<data>> &objects) {
+        assert(objects.size() == constant::count);
+        for (size_t i = 0; i < objects.size(); ++i) {
+            assert(objects[i]->id == int(i) * 3 + 1);
+            assert(objects[i]->number == int(i));
+            assert(objects[i]->text == "text " + std::to_string(i));
+        }
+    }
+
+}
+
+int main() {
+    std::remove(constant::db_name);
+
+    auto db = sqlite::database<data>::open(constant::db_name);
+    set_fields(db);
+
+    *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+
+    // Empty table
+
+    assert(db->scan_partitions(constant::table, constant::partitions).empty());
+
+    // Rowids with gaps
+
+    *db << BEGIN_TRANSACTION << ';';
+    for (int i = 0; i < constant::count; ++i) {
+        const auto object = std::make_shared<data>(data{0, i, "text " + std::to_string(i)});
+        *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+            << VALUES << '(' << i * 3 + 1 << object << ')' << ';';
+    }
+    *db << COMMIT << ';';
+
+    {
+        const auto partitions = db->scan_partitions(constant::table, constant::partitions);
+        assert(partitions.size() == constant::partitions);
+        for (const auto &objects: partitions) {
+            assert(!objects.empty());
+        }
+
+        std::vector<std::shared_ptr<data>> objects;
+        db->parallel_select(constant::table, objects, constant::partitions);
+        check(objects);
+
+        // Pooled connections are reused
+
+        objects.clear();
+        db->parallel_select(constant::table, objects);
+        check(objects);
+    }
+
+    // No file to open more connections on
+
+    {
+        auto snapshot = sqlite::database<data>::open_in_memory_snapshot(constant::db_name);
+        set_fields(snapshot);
+
+        assert(snapshot->scan_partitions(constant::table, constant::partitions).size() == 1);
+
+        std::vector<std::shared_ptr<data>> objects;
+        snapshot->parallel_select(constant::table, objects, constant::partitions);
+        check(objects);
+    }
+
+    return 0;
+}
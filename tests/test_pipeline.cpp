@@ -0,0 +1,123 @@
+//
+//  test_pipeline.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int number;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *table = "test_pipeline";
+        const int count = 10000;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db_with_data() {
+        auto db = sqlite::database<data>::open("test.db");
+        db->set_fields({{&data::id,     "id"},
+                        {&data::number, "number"},
+                        {&data::text,   "text"}});
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+        *db << DELETE << FROM << constant::table << ';';
+
+        *db << BEGIN_TRANSACTION << ';';
+        for (int i = 1; i <= constant::count; ++i) {
+            const auto object = std::make_shared<data>(data{0, i, i % 2 ? std::to_string(i) : ""});
+            *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << i << object << ')' << ';';
+        }
+        *db << COMMIT << ';';
+
+        return db;
+    }
+
+}
+
+int main() {
+    auto db = create_db_with_data();
+
+    // Every row is consumed once, with fields of reused objects overwritten
+
+    {
+        std::mutex mutex;
+        std::unordered_set<int> ids;
+        std::atomic<long long> sum(0);
+        std::unordered_set<std::thread::id> threads;
+
+        *db << SELECT << ALL << FROM << constant::table << ORDER_BY << &data::number << DESC;
+        const auto success = db->consume_parallel([&](const data &object) {
+            assert(object.id == object.number);
+            assert(object.text == (object.id % 2 ? std::to_string(object.id) : ""));
+            sum += object.number;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            ids.insert(object.id);
+            threads.insert(std::this_thread::get_id());
+        }, 3, 64, 2);
+
+        assert(success);
+        assert(ids.size() == constant::count);
+        assert(sum == (long long) constant::count * (constant::count + 1) / 2);
+        assert(threads.count(std::this_thread::get_id()) == 0);
+    }
+
+    // Partial batches and empty results
+
+    {
+        size_t count = 0;
+        *db << SELECT << ALL << FROM << constant::table << WHERE << &data::id << EQUALS << 1;
+        assert(db->consume_parallel([&count](const data &) { ++count; }, 2, 64));
+        assert(count == 1);
+
+        *db << SELECT << ALL << FROM << constant::table << WHERE << &data::id << EQUALS << -1;
+        assert(db->consume_parallel([&count](const data &) { ++count; }));
+        assert(count == 1);
+    }
+
+    // Idle workers and the blocked stepping thread wait for notifications instead of polling
+
+    {
+        std::atomic<int> count(0);
+        pipeline<data> pipeline(4, 1, 1, [&count](const data &) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            ++count;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        assert(pipeline.get_wakeups() <= 4 * 2);
+
+        for (int i = 0; i < 20; ++i) {
+            pipeline.next().id = i;
+        }
+        pipeline.finish();
+
+        assert(count == 20);
+
+        // A few checks per batch, where polling would make thousands
+
+        assert(pipeline.get_wakeups() < 20 * 8);
+    }
+
+    return 0;
+}
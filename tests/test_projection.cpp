@@ -0,0 +1,118 @@
+//
+//  test_projection.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <string>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int number;
+        std::string text;
+        std::string payload;
+    };
+
+    namespace constant {
+
+        const char *table = "test_projection";
+        const char *index = "test_projection_number_text";
+        const int count = 10;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db_with_data() {
+        auto db = sqlite::database<data>::open("test.db");
+        db->set_fields({{&data::id,      "id"},
+                        {&data::number,  "number"},
+                        {&data::text,    "text"},
+                        {&data::payload, "payload"}});
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+        *db << CREATE_INDEX_IF_NOT_EXISTS << constant::index << ON << constant::table
+            << '(' << &data::number << ',' << &data::text << ')' << ';';
+        *db << DELETE << FROM << constant::table << ';';
+
+        for (int i = 1; i <= constant::count; ++i) {
+            const auto object = std::make_shared<data>(data{0, i * 10, "text " + std::to_string(i),
+                                                             std::string(1000, 'a')});
+            *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << i << object << ')' << ';';
+        }
+
+        return db;
+    }
+
+}
+
+int main() {
+    auto db = create_db_with_data();
+
+    // Structured bindings
+
+    {
+        *db << FROM << constant::table << ORDER_BY << &data::id;
+        const auto rows = db->select(&data::id, &data::text);
+        assert(rows.size() == constant::count);
+
+        for (size_t i = 0; i < rows.size(); ++i) {
+            const auto &[id, text] = rows[i];
+            assert(id == int(i) + 1);
+            assert(text == "text " + std::to_string(i + 1));
+        }
+    }
+
+    // Filters, and fields in any order
+
+    {
+        *db << FROM << constant::table << WHERE << &data::number << '>' << 50 << ORDER_BY << &data::number << DESC;
+        const auto rows = db->select(&data::text, &data::number);
+        assert(rows.size() == 5);
+        assert(std::get<0>(rows.front()) == "text 10");
+        assert(std::get<1>(rows.front()) == 100);
+    }
+
+    // Served by the covering index
+
+    {
+        const auto query = std::string("EXPLAIN QUERY PLAN SELECT number,text FROM ") + constant::table +
+                           " WHERE number > 50";
+        sqlite3 *raw = nullptr;
+        sqlite3_open("test.db", &raw);
+
+        sqlite3_stmt *statement;
+        sqlite3_prepare_v2(raw, query.c_str(), -1, &statement, nullptr);
+        assert(sqlite3_step(statement) == SQLITE_ROW);
+        const std::string detail = reinterpret_cast<const char *>(sqlite3_column_text(statement, 3));
+        assert(detail.find("COVERING INDEX") != std::string::npos);
+        sqlite3_finalize(statement);
+        sqlite3_close(raw);
+    }
+
+    // Numbers are converted like those of objects
+
+    {
+        *db << UPDATE << constant::table << SET << &data::number << EQUALS << "1700000000000"
+            << WHERE << &data::id << EQUALS << 1 << ';';
+
+        *db << FROM << constant::table << WHERE << &data::id << EQUALS << 1;
+        const auto rows = db->select(&data::number);
+
+        *db << SELECT << ALL << FROM << constant::table << WHERE << &data::id << EQUALS << 1;
+        const std::vector<std::shared_ptr<data>> objects = *db;
+
+        assert(std::get<0>(rows.front()) == 1700000000);
+        assert(std::get<0>(rows.front()) == objects.front()->number);
+    }
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+//
+//  test_query_cache.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <string>
+#include <thread>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int number;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *table = "test_query_cache";
+        const char *other_table = "test_query_cache_other";
+        const size_t count = 3;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db_with_data() {
+        auto db = sqlite::database<data>::open("test.db");
+        db->set_fields({{&data::id,     "id"},
+                        {&data::number, "number"},
+                        {&data::text,   "text"}});
+
+        for (const auto table: {constant::table, constant::other_table}) {
+            *db << CREATE_TABLE_IF_NOT_EXISTS << table << '(' << ALL << ')' << ';';
+            *db << DELETE << FROM << table << ';';
+
+            for (size_t i = 1; i <= constant::count; ++i) {
+                const auto object = std::make_shared<data>(data{0, int(i), "text"});
+                *db << INSERT_OR_REPLACE_INTO << table << '(' << ALL << ')'
+                    << VALUES << '(' << int(i) << object << ')' << ';';
+            }
+        }
+
+        return db;
+    }
+
+    std::vector<std::shared_ptr<data>> select_all(const std::shared_ptr<sqlite::database<data>> &db) {
+        std::vector<std::shared_ptr<data>> objects;
+        *db << SELECT << ALL << FROM << constant::table;
+        *db >> objects;
+        return objects;
+    }
+
+}
+
+int main() {
+
+    // Repeated reads
+
+    {
+        auto db = create_db_with_data();
+        db->enable_query_cache();
+
+        const auto objects = select_all(db);
+        assert(objects.size() == constant::count);
+        assert(select_all(db) == objects);
+
+        for (size_t i = 0; i < 2; ++i) {
+            *db << SELECT << COUNT << FROM << constant::table;
+
+            size_t count = 0;
+            *db >> count;
+            assert(count == constant::count);
+        }
+
+        std::vector<int> numbers;
+        *db << SELECT << ALL << FROM << constant::table;
+        *db >> &data::number >> numbers;
+        assert(numbers.size() == constant::count);
+
+        const auto statistics = db->get_query_cache_statistics();
+        assert(statistics.hits == 2);
+        assert(statistics.misses == 3);
+    }
+
+    // Modifications of read tables
+
+    {
+        auto db = create_db_with_data();
+        db->enable_query_cache();
+
+        const auto objects = select_all(db);
+
+        *db << UPDATE << constant::table << SET << &data::number << EQUALS << 10
+            << WHERE << &data::id << EQUALS << 1 << ';';
+
+        const auto updated = select_all(db);
+        assert(updated != objects);
+        assert(updated.front()->number == 10);
+        assert(db->get_query_cache_statistics().invalidations == 1);
+
+        *db << DELETE << FROM << constant::table << ';';
+        assert(select_all(db).empty());
+    }
+
+    // Rollback of modifications read inside the transaction
+
+    {
+        auto db = create_db_with_data();
+        db->enable_query_cache();
+
+        *db << BEGIN_TRANSACTION << ';';
+        *db << UPDATE << constant::table << SET << &data::number << EQUALS << 10
+            << WHERE << &data::id << EQUALS << 1 << ';';
+        assert(select_all(db).front()->number == 10);
+        *db << ROLLBACK << ';';
+
+        assert(select_all(db).front()->number == 1);
+    }
+
+    // Modifications of other tables
+
+    {
+        auto db = create_db_with_data();
+        db->enable_query_cache();
+
+        const auto objects = select_all(db);
+
+        *db << UPDATE << constant::other_table << SET << &data::number << EQUALS << 10 << ';';
+
+        assert(select_all(db) == objects);
+    }
+
+    // Queries with bound parameters, whose statements are reused
+
+    {
+        auto db = create_db_with_data();
+
+        const auto select_ids = [&db](const std::vector<int> &ids) {
+            std::vector<std::shared_ptr<data>> objects;
+            *db << SELECT << ALL << FROM << constant::table << WHERE << &data::id << IN << bind_list(ids);
+            *db >> objects;
+            return objects;
+        };
+
+        select_ids({1});
+        db->enable_query_cache();
+
+        for (const auto &ids: {std::vector<int>{1}, std::vector<int>{1, 2}}) {
+            const auto objects = select_ids(ids);
+            assert(objects.size() == ids.size());
+            assert(select_ids(ids) == objects);
+        }
+        assert(db->get_query_cache_statistics().hits == 2);
+
+        *db << UPDATE << constant::table << SET << &data::number << EQUALS << 10
+            << WHERE << &data::id << EQUALS << 1 << ';';
+        assert(select_ids({1}).front()->number == 10);
+    }
+
+    // Capacity and expiration
+
+    {
+        auto db = create_db_with_data();
+        db->enable_query_cache(1, std::chrono::milliseconds(50));
+
+        const auto objects = select_all(db);
+
+        std::vector<std::shared_ptr<data>> others;
+        *db << SELECT << ALL << FROM << constant::other_table;
+        *db >> others;
+        assert(db->get_query_cache_statistics().evictions == 1);
+        assert(select_all(db) != objects);
+
+        const auto cached = select_all(db);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        assert(select_all(db) != cached);
+    }
+
+    // Disabled cache
+
+    {
+        auto db = create_db_with_data();
+        db->enable_query_cache();
+        db->disable_query_cache();
+
+        assert(select_all(db) != select_all(db));
+        assert(db->get_query_cache_statistics().misses == 0);
+    }
+
+    return 0;
+}
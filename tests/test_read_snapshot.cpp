@@ -0,0 +1,113 @@
+//
+//  test_read_snapshot.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <string>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *db_name = "test_read_snapshot.db";
+        const char *table = "test_read_snapshot";
+        const int count = 100;
+
+    }
+
+    void insert(const std::shared_ptr<sqlite::database<data>> &db, int count) {
+        *db << BEGIN_TRANSACTION << ';';
+        for (int i = 0; i < count; ++i) {
+            const auto object = std::make_shared<data>(data{0, "text"});
+            *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << "null" << object << ')' << ';';
+        }
+        *db << COMMIT << ';';
+    }
+
+    sqlite3 *open_read_only() {
+        sqlite3 *db = nullptr;
+        sqlite3_open_v2(constant::db_name, &db, SQLITE_OPEN_READONLY, nullptr);
+        return db;
+    }
+
+    int count(sqlite3 *db) {
+        sqlite3_stmt *statement;
+        const auto query = std::string("SELECT count(*) FROM ") + constant::table;
+        sqlite3_prepare_v2(db, query.c_str(), -1, &statement, nullptr);
+        sqlite3_step(statement);
+        const auto count = sqlite3_column_int(statement, 0);
+        sqlite3_finalize(statement);
+        return count;
+    }
+
+}
+
+int main() {
+    std::remove(constant::db_name);
+
+    auto db = sqlite::database<data>::open(constant::db_name);
+    db->set_fields({{&data::id,   "id"},
+                    {&data::text, "text"}});
+
+    *db << PRAGMA << "journal_mode = WAL";
+    const std::vector<std::string> journal_mode = *db;
+    assert(journal_mode.front() == "wal");
+
+    *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+    insert(db, constant::count);
+
+    const auto source = open_read_only();
+    const auto other = open_read_only();
+
+    {
+        const read_snapshot snapshot(source);
+
+        insert(db, constant::count);
+
+#ifdef SQLITE_ORM_ENABLE_SNAPSHOT
+        assert(snapshot.is_valid());
+        assert(count(source) == constant::count);
+
+        assert(snapshot.open(other));
+        assert(count(other) == constant::count);
+        read_snapshot::close(other);
+#else
+        assert(!snapshot.is_valid());
+        assert(sqlite3_get_autocommit(source));
+        assert(!snapshot.open(other));
+#endif
+
+        assert(sqlite3_get_autocommit(other));
+        assert(count(other) == constant::count * 2);
+    }
+
+    // The source is released with the snapshot
+
+    assert(sqlite3_get_autocommit(source));
+    assert(count(source) == constant::count * 2);
+
+    sqlite3_close(source);
+    sqlite3_close(other);
+
+    // Parallel scans with the snapshot, or without it when unsupported
+
+    std::vector<std::shared_ptr<data>> objects;
+    db->parallel_select(constant::table, objects, 4);
+    assert(objects.size() == constant::count * 2);
+
+    return 0;
+}
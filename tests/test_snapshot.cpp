@@ -0,0 +1,131 @@
+//
+//  test_snapshot.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <string>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *db_name = "test_snapshot.db";
+        const char *serialized_db_name = "test_snapshot_serialized.db";
+        const char *table = "test_snapshot";
+        const size_t count = 10;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> set_fields(std::shared_ptr<sqlite::database<data>> db) {
+        db->set_fields({{&data::id,   "id"},
+                        {&data::text, "text"}});
+        return db;
+    }
+
+    size_t count(const std::shared_ptr<sqlite::database<data>> &db) {
+        *db << SELECT << COUNT << FROM << constant::table;
+        return *db;
+    }
+
+}
+
+int main() {
+    std::remove(constant::db_name);
+    std::remove(constant::serialized_db_name);
+
+    // File
+
+    {
+        auto db = set_fields(sqlite::database<data>::open(constant::db_name));
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+        for (size_t i = 0; i < constant::count; ++i) {
+            const auto object = std::make_shared<data>(data{0, "text"});
+            *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << "null" << object << ')' << ';';
+        }
+
+        assert(db->get_last_errors().empty());
+    }
+
+    sqlite::database<data>::clear_cache();
+
+    // Snapshot
+
+    {
+        auto db = set_fields(sqlite::database<data>::open_in_memory_snapshot(constant::db_name));
+        assert(count(db) == constant::count);
+
+        auto cached_db = set_fields(sqlite::database<data>::open(constant::db_name));
+        assert(count(cached_db) == constant::count);
+
+        const auto object = std::make_shared<data>(data{0, "text"});
+        *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+            << VALUES << '(' << "null" << object << ')' << ';';
+        assert(db->get_last_errors().empty());
+        assert(count(cached_db) == constant::count + 1);
+
+        assert(db->serialize(constant::serialized_db_name));
+    }
+
+    sqlite::database<data>::clear_cache();
+
+    // File is untouched
+
+    {
+        auto db = set_fields(sqlite::database<data>::open_read_only(constant::db_name));
+        assert(count(db) == constant::count);
+    }
+
+    // Serialized
+
+    {
+        auto db = set_fields(sqlite::database<data>::open_read_only(constant::serialized_db_name));
+        assert(count(db) == constant::count + 1);
+    }
+
+    // Snapshot of a path that is still open
+
+    {
+        auto file_db = set_fields(sqlite::database<data>::open(constant::db_name));
+        assert(count(file_db) == constant::count);
+
+        auto db = set_fields(sqlite::database<data>::open_in_memory_snapshot(constant::db_name));
+        const auto object = std::make_shared<data>(data{0, "text"});
+        *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+            << VALUES << '(' << "null" << object << ')' << ';';
+        assert(count(db) == constant::count + 1);
+
+        assert(count(file_db) == constant::count);
+        assert(file_db->get_last_errors().empty());
+        assert(count(set_fields(sqlite::database<data>::open(constant::db_name))) == constant::count + 1);
+    }
+
+    sqlite::database<data>::clear_cache();
+
+    // Missing file
+
+    {
+        auto db = set_fields(sqlite::database<data>::open_in_memory_snapshot("missing.db"));
+        assert(db);
+        assert(db->get_last_errors().size() == 1);
+        assert(count(db) == 0);
+    }
+
+    sqlite::database<data>::clear_cache();
+
+    return 0;
+}
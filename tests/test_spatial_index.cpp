@@ -0,0 +1,95 @@
+//
+//  test_spatial_index.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <string>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int x;
+        int y;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *table = "test_spatial_index";
+        const int size = 10;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db_with_data() {
+        auto db = sqlite::database<data>::open("test.db");
+        db->set_fields({{&data::id,   "id"},
+                        {&data::x,    "x"},
+                        {&data::y,    "y"},
+                        {&data::text, "text"}});
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+        *db << DELETE << FROM << constant::table << ';';
+
+        // A grid of points, one per unit
+
+        int id = 1;
+        for (int x = 0; x < constant::size; ++x) {
+            for (int y = 0; y < constant::size; ++y) {
+                const auto object = std::make_shared<data>(data{0, x, y, std::to_string(x) + ":" + std::to_string(y)});
+                *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                    << VALUES << '(' << id++ << object << ')' << ';';
+            }
+        }
+
+        return db;
+    }
+
+}
+
+int main() {
+    auto db = create_db_with_data();
+
+    // Existing rows are indexed
+
+    {
+        assert(db->enable_spatial_index(constant::table, &data::x, &data::y));
+        assert(db->enable_spatial_index(constant::table, &data::x, &data::y));
+
+        assert(db->find_in_box(constant::table, 0, 9, 0, 9).size() == 100);
+        assert(db->find_in_box(constant::table, 2, 4, 5, 6).size() == 6);
+        assert(db->find_in_box(constant::table, 20, 30, 0, 9).empty());
+
+        const auto corner = db->find_in_box(constant::table, -5, 0, -5, 0);
+        assert(corner.size() == 1 && corner.front()->text == "0:0");
+    }
+
+    // Triggers keep the index in sync
+
+    {
+        *db << UPDATE << constant::table << SET << &data::x << EQUALS << 50 << ',' << &data::y << EQUALS << 50
+            << WHERE << &data::id << EQUALS << 1 << ';';
+        assert(db->find_in_box(constant::table, -5, 0, -5, 0).empty());
+        assert(db->find_in_box(constant::table, 40, 60, 40, 60).front()->id == 1);
+
+        const auto object = std::make_shared<data>(data{0, -3, -3, "moved"});
+        *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+            << VALUES << '(' << 1 << object << ')' << ';';
+        assert(db->find_in_box(constant::table, 40, 60, 40, 60).empty());
+        assert(db->find_in_box(constant::table, -5, 0, -5, 0).front()->text == "moved");
+
+        *db << DELETE << FROM << constant::table << WHERE << &data::x << EQUALS << 9 << ';';
+        assert(db->find_in_box(constant::table, 5, 9, 0, 9).size() == 40);
+        assert(db->get_last_errors().empty());
+    }
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+//
+//  test_subscription.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <string>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int number;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *table = "test_subscription";
+        const char *other_table = "test_subscription_other";
+        const size_t count = 3;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db_with_data() {
+        auto db = sqlite::database<data>::open("test.db");
+        db->set_fields({{&data::id,     "id"},
+                        {&data::number, "number"},
+                        {&data::text,   "text"}});
+
+        for (const auto table: {constant::table, constant::other_table}) {
+            *db << CREATE_TABLE_IF_NOT_EXISTS << table << '(' << ALL << ')' << ';';
+            *db << DELETE << FROM << table << ';';
+
+            for (size_t i = 1; i <= constant::count; ++i) {
+                const auto object = std::make_shared<data>(data{0, int(i), "text"});
+                *db << INSERT_OR_REPLACE_INTO << table << '(' << ALL << ')'
+                    << VALUES << '(' << int(i) << object << ')' << ';';
+            }
+        }
+
+        return db;
+    }
+
+    void insert(const std::shared_ptr<sqlite::database<data>> &db, const char *table, int id) {
+        const auto object = std::make_shared<data>(data{0, id, "text"});
+        *db << INSERT_OR_REPLACE_INTO << table << '(' << ALL << ')'
+            << VALUES << '(' << id << object << ')' << ';';
+    }
+
+    void update(const std::shared_ptr<sqlite::database<data>> &db, int id, int number) {
+        *db << UPDATE << constant::table << SET << &data::number << EQUALS << number
+            << WHERE << &data::id << EQUALS << id << ';';
+    }
+
+}
+
+int main() {
+
+    // Autocommit
+
+    {
+        auto db = create_db_with_data();
+
+        std::vector<sqlite::changes<data>> received;
+        db->subscribe(constant::table, [&received](const sqlite::changes<data> &changes) {
+            received.push_back(changes);
+        });
+
+        insert(db, constant::table, 10);
+        assert(received.size() == 1);
+        assert(received[0].inserted == std::vector<sqlite3_int64>{10});
+        assert(received[0].objects.empty());
+
+        update(db, 1, 100);
+        assert(received.size() == 2);
+        assert(received[1].updated == std::vector<sqlite3_int64>{1});
+
+        *db << DELETE << FROM << constant::table << ';';
+        assert(received.size() == 3);
+        assert(received[2].deleted == (std::vector<sqlite3_int64>{1, 2, 3, 10}));
+
+        // Other tables
+
+        insert(db, constant::other_table, 10);
+        assert(received.size() == 3);
+    }
+
+    // Transactions
+
+    {
+        auto db = create_db_with_data();
+
+        std::vector<sqlite::changes<data>> received;
+        db->subscribe(constant::table, [&received](const sqlite::changes<data> &changes) {
+            received.push_back(changes);
+        }, true);
+
+        *db << BEGIN_TRANSACTION << ';';
+        insert(db, constant::table, 10);
+        update(db, 10, 100);
+        insert(db, constant::table, 11);
+        *db << DELETE << FROM << constant::table << WHERE << &data::id << EQUALS << 11 << ';';
+        update(db, 1, 100);
+        *db << DELETE << FROM << constant::table << WHERE << &data::id << EQUALS << 2 << ';';
+        assert(received.empty());
+        *db << COMMIT << ';';
+
+        assert(received.size() == 1);
+        const auto &changes = received.front();
+        assert(changes.inserted == std::vector<sqlite3_int64>{10});
+        assert(changes.updated == std::vector<sqlite3_int64>{1});
+        assert(changes.deleted == std::vector<sqlite3_int64>{2});
+        assert(changes.objects.size() == 2);
+        assert(changes.objects.at(10)->number == 100);
+        assert(changes.objects.at(1)->number == 100);
+
+        // Rollback
+
+        *db << BEGIN_TRANSACTION << ';';
+        insert(db, constant::table, 20);
+        *db << ROLLBACK << ';';
+        assert(received.size() == 1);
+    }
+
+    // Unsubscribe
+
+    {
+        auto db = create_db_with_data();
+
+        size_t count = 0;
+        const auto id = db->subscribe(constant::table, [&count](const sqlite::changes<data> &) {
+            ++count;
+        });
+
+        insert(db, constant::table, 10);
+        assert(count == 1);
+
+        db->unsubscribe(id);
+        insert(db, constant::table, 11);
+        assert(count == 1);
+    }
+
+    return 0;
+}
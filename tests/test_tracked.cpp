@@ -0,0 +1,129 @@
+//
+//  test_tracked.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <string>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int number;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *table = "test_tracked";
+        const size_t count = 3;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db_with_data() {
+        auto db = sqlite::database<data>::open("test.db");
+        db->set_fields({{&data::id,     "id"},
+                        {&data::number, "number"},
+                        {&data::text,   "text"}});
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+        *db << DELETE << FROM << constant::table << ';';
+
+        for (size_t i = 1; i <= constant::count; ++i) {
+            const auto object = std::make_shared<data>(data{0, int(i), "text"});
+            *db << INSERT_OR_REPLACE_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << int(i) << object << ')' << ';';
+        }
+
+        return db;
+    }
+
+    std::shared_ptr<data> select(const std::shared_ptr<sqlite::database<data>> &db, int id) {
+        *db << SELECT << ALL << FROM << constant::table << WHERE << &data::id << EQUALS << id;
+        const std::vector<std::shared_ptr<data>> objects = *db;
+        return objects.front();
+    }
+
+}
+
+int main() {
+    auto db = create_db_with_data();
+
+    std::vector<sqlite::changes<data>> received;
+    db->subscribe(constant::table, [&received](const sqlite::changes<data> &changes) {
+        received.push_back(changes);
+    });
+
+    auto object = db->track(select(db, 1));
+
+    // Nothing changed
+
+    assert(db->get_dirty_fields(object).empty());
+    assert(db->save(constant::table, object));
+    assert(received.empty());
+
+    // Only changed fields are written
+
+    object->number = 10;
+    assert(db->get_dirty_fields(object) == std::vector<size_t>{1});
+
+    *db << UPDATE << constant::table << SET << &data::text << EQUALS << "'changed elsewhere'"
+        << WHERE << &data::id << EQUALS << 1 << ';';
+    received.clear();
+
+    assert(db->save(constant::table, object));
+    assert(db->get_dirty_fields(object).empty());
+
+    auto saved = select(db, 1);
+    assert(saved->number == 10);
+    assert(saved->text == "changed elsewhere");
+
+    // The row is updated in place
+
+    assert(received.size() == 1);
+    assert(received.front().updated == std::vector<sqlite3_int64>{1});
+    assert(received.front().inserted.empty());
+    assert(received.front().deleted.empty());
+
+    // Cached statements are rebound
+
+    object->number = 20;
+    object->text = "text 20";
+    assert(db->get_dirty_fields(object) == (std::vector<size_t>{1, 2}));
+    assert(db->save(constant::table, object));
+
+    object->number = 30;
+    assert(db->save(constant::table, object));
+
+    saved = select(db, 1);
+    assert(saved->number == 30);
+    assert(saved->text == "text 20");
+
+    assert(select(db, 2)->number == 2);
+
+    // Deleted rows and failed statements keep the object dirty
+
+    auto deleted = db->track(select(db, 3));
+    *db << DELETE << FROM << constant::table << WHERE << &data::id << EQUALS << 3 << ';';
+
+    const auto errors = db->get_last_errors().size();
+    deleted->number = 40;
+    assert(!db->save(constant::table, deleted));
+    assert(db->get_dirty_fields(deleted) == std::vector<size_t>{1});
+    assert(db->get_last_errors().size() == errors + 1);
+
+    object->number = 50;
+    assert(!db->save("missing_table", object));
+    assert(db->get_dirty_fields(object) == std::vector<size_t>{1});
+    assert(db->get_last_errors().size() == errors + 2);
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+//
+//  test_upsert.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cassert>
+#include <string>
+
+#include <sqlite_orm/database.h>
+
+using namespace sqlite;
+
+namespace {
+
+    struct data {
+        int id;
+        int number;
+        std::string text;
+    };
+
+    namespace constant {
+
+        const char *table = "test_upsert";
+        const char *index = "test_upsert_number";
+        const int count = 3;
+
+    }
+
+    std::shared_ptr<sqlite::database<data>> create_db_with_data() {
+        auto db = sqlite::database<data>::open("test.db");
+        db->set_fields({{&data::id,     "id"},
+                        {&data::number, "number"},
+                        {&data::text,   "text"}});
+        db->set_unique_key(&data::number);
+
+        *db << CREATE_TABLE_IF_NOT_EXISTS << constant::table << '(' << ALL << ')' << ';';
+        *db << CREATE_UNIQUE_INDEX_IF_NOT_EXISTS << constant::index << ON << constant::table
+            << '(' << UNIQUE_KEY << ')' << ';';
+        *db << DELETE << FROM << constant::table << ';';
+
+        for (int i = 1; i <= constant::count; ++i) {
+            const auto object = std::make_shared<data>(data{0, i, "text"});
+            *db << INSERT_INTO << constant::table << '(' << ALL << ')'
+                << VALUES << '(' << i << object << ')' << ON_CONFLICT << ';';
+        }
+
+        return db;
+    }
+
+    std::vector<std::shared_ptr<data>> select_all(const std::shared_ptr<sqlite::database<data>> &db) {
+        *db << SELECT << ALL << FROM << constant::table << ORDER_BY << &data::id;
+        return *db;
+    }
+
+}
+
+int main() {
+
+    // Conflicting rows are updated in place
+
+    {
+        auto db = create_db_with_data();
+
+        std::vector<sqlite::changes<data>> received;
+        db->subscribe(constant::table, [&received](const sqlite::changes<data> &changes) {
+            received.push_back(changes);
+        });
+
+        const auto object = std::make_shared<data>(data{0, 2, "updated"});
+        *db << INSERT_INTO << constant::table << '(' << ALL << ')'
+            << VALUES << '(' << "null" << object << ')' << ON_CONFLICT << ';';
+
+        const auto objects = select_all(db);
+        assert(objects.size() == constant::count);
+        assert(objects[1]->id == 2);
+        assert(objects[1]->text == "updated");
+
+        assert(received.size() == 1);
+        assert(received.front().updated == std::vector<sqlite3_int64>{2});
+        assert(received.front().deleted.empty());
+    }
+
+    // Id as the conflict target
+
+    {
+        auto db = create_db_with_data();
+        db->set_unique_key();
+
+        const auto object = std::make_shared<data>(data{0, 10, "updated"});
+        *db << INSERT_INTO << constant::table << '(' << ALL << ')'
+            << VALUES << '(' << 1 << object << ')' << ON_CONFLICT << ';';
+
+        const auto objects = select_all(db);
+        assert(objects.size() == constant::count);
+        assert(objects[0]->number == 10);
+    }
+
+    // Bulk
+
+    {
+        auto db = create_db_with_data();
+
+        const std::vector<std::shared_ptr<data>> objects = {
+                std::make_shared<data>(data{0, 1, "bulk 1"}),
+                std::make_shared<data>(data{0, 3, "bulk 3"}),
+                std::make_shared<data>(data{0, 4, "bulk 4"}),
+                std::make_shared<data>(data{10, 5, "bulk 5"})};
+        assert(db->upsert(constant::table, objects));
+
+        const auto saved = select_all(db);
+        assert(saved.size() == 5);
+        assert(saved[0]->id == 1 && saved[0]->text == "bulk 1");
+        assert(saved[1]->id == 2 && saved[1]->text == "text");
+        assert(saved[2]->id == 3 && saved[2]->text == "bulk 3");
+        assert(saved[3]->id == 4 && saved[3]->number == 4);
+        assert(saved[4]->id == 10 && saved[4]->number == 5);
+
+        // A failing row rolls the batch back
+
+        const std::vector<std::shared_ptr<data>> conflicting = {
+                std::make_shared<data>(data{0, 6, "bulk 6"}),
+                std::make_shared<data>(data{1, 7, "bulk 7"})};
+        const auto errors = db->get_last_errors().size();
+        assert(!db->upsert(constant::table, conflicting));
+        assert(select_all(db).size() == 5);
+        assert(db->get_last_errors().size() == errors + 1);
+
+        assert(!db->upsert("missing_table", objects));
+        assert(db->get_last_errors().size() == errors + 2);
+    }
+
+    return 0;
+}
@@ -0,0 +1,28 @@
+//
+//  sqlite_orm_pack.cpp
+//  sqlite_orm
+//
+//  Created by Dmitrii Torkhov <dmitriitorkhov@gmail.com> on 19.10.2026.
+//  Copyright © 2026 Dmitrii Torkhov. All rights reserved.
+//
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <sqlite_orm/compressed_vfs.h>
+
+int main(int argc, char *argv[]) {
+    if (argc != 3 && argc != 4) {
+        fprintf(stderr, "Usage: %s <source.db> <destination> [chunk_size]\n", argv[0]);
+        return 1;
+    }
+
+    const size_t chunk_size = argc == 4 ? strtoul(argv[3], nullptr, 10) : 64 * 1024;
+
+    if (!sqlite::pack_database(argv[1], argv[2], chunk_size)) {
+        fprintf(stderr, "Failed to pack %s\n", argv[1]);
+        return 1;
+    }
+
+    return 0;
+}